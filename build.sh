@@ -27,9 +27,10 @@ build_genesis_game() {
         return 1
     fi
     
-    # Build with SGDK Docker
+    # Build with SGDK Docker (shared engine code is mounted as src/common)
     docker run --rm \
-        -v "$game_dir:/src" \
+        -v "$(cd "$game_dir" && pwd):/src" \
+        -v "$SCRIPT_DIR/genesis/common:/src/src/common:ro" \
         -w /src \
         "$SGDK_IMAGE" \
         make -f /sgdk/makefile.gen
@@ -54,7 +55,8 @@ build_all_genesis() {
     local failed=0
     
     for game in genesis/*/; do
-        if [ -d "$game" ]; then
+        # Skip shared code (genesis/common) and anything else that isn't a game
+        if [ -d "$game/src" ]; then
             if build_genesis_game "$game"; then
                 ((count++))
             else
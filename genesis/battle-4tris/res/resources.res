@@ -1,2 +1,11 @@
 # Resources file for Battle Tetris
-# Currently using programmatic tiles - no external resources needed
+
+# All game tiles in tile index order (tiles.png, 8x8 each, left to right).
+# NONE keeps the order so the TILE_* defines in main.c stay valid.
+TILESET game_tiles "tiles.png" BEST NONE
+
+# Impact sample, mixed by the Z80 driver
+WAV impact_pcm "impact.wav" XGM2
+
+# In-game music, a YM2612 log converted for the Z80 driver
+XGM2 game_music "game.vgm"
@@ -4,31 +4,63 @@
  */
 
 #include <genesis.h>
+#include "resources.h"
+
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/fastdiv.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/rng.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/tilemap.h"
+#include "common/vram.h"
 
 #define FIELD_W     10
 #define FIELD_H     20
-#define TILE_EMPTY  0
-#define TILE_BLOCK  1
-#define TILE_GHOST  2
-#define TILE_SPARK  3
+#define TILE_EMPTY  (gameTiles + 0)
+#define TILE_BLOCK  (gameTiles + 1)
+#define TILE_GHOST  (gameTiles + 2)
+#define TILE_SPARK  (gameTiles + 3)
+#define TILE_FLASH  (gameTiles + 4)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
+
+// CRAM entry TILE_FLASH is drawn with; blinking happens there
+#define FLASH_COLOR 2
+
+// HUD counters (bottom four rows, under the wells)
+#define HUD_SCORE   0
+#define HUD_LINES   1
+#define HUD_LEVEL   2
+#define HUD_COMBO   3
 
 static u8 field1[FIELD_H][FIELD_W];
 static u8 field2[FIELD_H][FIELD_W];
 static s8 pieceX, pieceY, pieceType, pieceRot;
 static u8 nextPiece;
-static u16 score1, score2, lines1, lines2;
+static u32 score1, score2;
+static u16 lines1, lines2;
 static u8 dropTimer, dropSpeed;
 static u8 gameState, gameMode;
 static u8 currentPlayer;
 static u16 frameCount;
-static u16 seed = 12345;
 
 // PIZZAZZ!
 static u8 soundEnabled = 1;
-static s16 shakeX = 0, shakeY = 0;
-static u8 shakeTimer = 0;
-static u16 highScore = 0;
-static u8 titleFrame = 0;
+static u32 highScore = 0;
+// Formatted once per state change rather than every frame
+static char hiScoreText[28];
+static char finalText[2][28];
+// Title piece: drops a row every 6 frames, next shape every 8 rows
+static u8 titlePieceY = 0, titlePieceType = 0;
+static u8 titleTimer = 0;
 static u8 lineClearFlash = 0;
 static u8 flashY[4] = {0, 0, 0, 0};
 static u8 flashCount = 0;
@@ -37,6 +69,7 @@ static u8 combo = 0;
 static u8 lastWasLineClear = 0;
 static u8 lockDelay = 0;
 static u8 hardDropping = 0;
+static u8 wellDirty = 0;  // locked cells or next piece changed since BG_B was drawn
 
 static const u16 PIECES[7][4] = {
     {0x0F00, 0x2222, 0x00F0, 0x4444}, // I - cyan
@@ -51,132 +84,90 @@ static const u16 PIECES[7][4] = {
 // Piece colors (palette index)
 static const u8 PIECE_COLORS[7] = {1, 2, 3, 1, 3, 2, 2};
 
-static u16 rnd() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7FFF; }
-
 // ============ SOUND EFFECTS ============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+static const SfxStep moveSteps[] = { { 400, 9, 2, 0, 1 }, SFX_END };
+static const SfxStep rotateSteps[] = { { 800, 12, 3, 0, 1 }, SFX_END };
+static const SfxStep lockSteps[] = { { 200, 13, 5, 0, 1 }, SFX_END };
+static const SfxStep clearSteps[] = { { 600, 15, 10, 10, 1 }, SFX_END };
+static const SfxStep hardDropSteps[] = { { 300, 15, 5, -20, 1 }, SFX_END };
+static const SfxStep gameOverSteps[] = {
+    { 400, 15, 8, 0, 0 }, { 340, 15, 8, 0, 0 }, { 280, 15, 8, 0, 0 },
+    { 220, 15, 8, 0, 0 }, { 160, 15, 16, 0, 1 }, SFX_END
+};
+static const SfxStep blipSteps[] = { { 1000, 12, 3, 0, 1 }, SFX_END };
+static const SfxStep comboSteps[] = { { 1000, 14, 5, 20, 1 }, SFX_END };
+
+static const Sfx sfxMove = { SFX_PRIO_LOW, FALSE, moveSteps };
+static const Sfx sfxRotate = { SFX_PRIO_LOW, FALSE, rotateSteps };
+static const Sfx sfxLock = { SFX_PRIO_MID, FALSE, lockSteps };
+static const Sfx sfxClear = { SFX_PRIO_HIGH, FALSE, clearSteps };
+static const Sfx sfxHardDrop = { SFX_PRIO_MID, FALSE, hardDropSteps };
+static const Sfx sfxGameOver = { SFX_PRIO_JINGLE, FALSE, gameOverSteps };
+static const Sfx sfxBlip = { SFX_PRIO_LOW, FALSE, blipSteps };
+static const Sfx sfxCombo = { SFX_PRIO_MID, FALSE, comboSteps };
+
 static void playMove() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX - 6);
-    PSG_setFrequency(0, 400);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 2);
+    SFX_play(&sfxMove);
 }
 
 static void playRotate() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 800);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 3);
+    SFX_play(&sfxRotate);
 }
 
 static void playLock() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 200);
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 6);
+    SFX_play(&sfxLock);
 }
 
 static void playLineClear(u8 lines) {
     if (!soundEnabled) return;
-    u16 freq = 600 + lines * 200;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, freq);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 8);
+    SFX_playPitch(&sfxClear, lines * 200);
     
     if (lines == 4) {
-        // 4-LINE!
-        PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(1, 1200);
-        PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 8);
-        PSG_setEnvelope(2, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(2, 1600);
-        PSG_setEnvelope(2, PSG_ENVELOPE_MIN + 8);
+        // 4-LINE! A chord on the other two channels
+        SFX_playPitch(&sfxClear, 600);
+        SFX_playPitch(&sfxClear, 1000);
     }
 }
 
 static void playHardDrop() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 300);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 4);
-    PSG_setEnvelope(3, PSG_ENVELOPE_MAX - 8);
-    PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_TONE3);
+    SFX_play(&sfxHardDrop);
+    AUD_PLAY_PCM(impact_pcm, SFX_PRIO_MID);
 }
 
 static void playGameOver() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 5; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 400 - i * 60);
-        for (u16 j = 0; j < 5000; j++) {}
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
+    SFX_play(&sfxGameOver);
 }
 
 static void playMenuBlip() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1000);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 2);
+    SFX_play(&sfxBlip);
 }
 
 static void playCombo() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1000 + combo * 150);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 4);
+    SFX_playPitch(&sfxCombo, combo * 150);
 }
 
-static void updateSound() {
-    static u8 fadeTimer = 0;
-    fadeTimer++;
-    if (fadeTimer > 3) {
-        fadeTimer = 0;
-        for (u8 ch = 0; ch < 4; ch++) {
-            PSG_setEnvelope(ch, PSG_ENVELOPE_MIN);
-        }
-    }
+// Background track, on the Z80 for the whole game
+static void playMusic() {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============ SCREEN SHAKE ============
 static void startShake(u8 intensity) {
-    shakeTimer = intensity;
-}
-
-static void updateShake() {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeY = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeTimer--;
-    } else {
-        shakeX = shakeY = 0;
-    }
-    VDP_setHorizontalScroll(BG_A, shakeX);
-    VDP_setVerticalScroll(BG_A, shakeY);
+    SCRL_shake(SCRL_LAYERS, intensity, intensity);
 }
 
 static void createTiles() {
-    u32 td[8];
-    memset(td, 0, 32); VDP_loadTileData(td, TILE_EMPTY, 1, CPU);
-    memset(td, 0x11, 32); VDP_loadTileData(td, TILE_BLOCK, 1, CPU);
-    
-    // Ghost piece (hollow)
-    td[0] = 0x11111111;
-    td[1] = 0x10000001;
-    td[2] = 0x10000001;
-    td[3] = 0x10000001;
-    td[4] = 0x10000001;
-    td[5] = 0x10000001;
-    td[6] = 0x10000001;
-    td[7] = 0x11111111;
-    VDP_loadTileData(td, TILE_GHOST, 1, CPU);
-    
-    // Spark
-    memset(td, 0, 32);
-    td[2] = 0x00110000;
-    td[3] = 0x01111100;
-    td[4] = 0x01111100;
-    td[5] = 0x00110000;
-    VDP_loadTileData(td, TILE_SPARK, 1, CPU);
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
 }
 
 static bool checkCollision(u8 field[FIELD_H][FIELD_W], s8 px, s8 py, u8 type, u8 rot) {
@@ -216,7 +207,7 @@ static void lockPiece(u8 field[FIELD_H][FIELD_W]) {
     playLock();
 }
 
-static u8 clearLines(u8 field[FIELD_H][FIELD_W], u16* score, u16* lines) {
+static u8 clearLines(u8 field[FIELD_H][FIELD_W], u32* score, u16* lines) {
     u8 cleared = 0;
     flashCount = 0;
     
@@ -237,7 +228,7 @@ static u8 clearLines(u8 field[FIELD_H][FIELD_W], u16* score, u16* lines) {
         *lines += cleared;
         
         // Scoring with combos and line bonuses
-        u16 baseScore = 0;
+        u32 baseScore = 0;
         switch(cleared) {
             case 1: baseScore = 100; break;
             case 2: baseScore = 300; break;
@@ -261,12 +252,18 @@ static u8 clearLines(u8 field[FIELD_H][FIELD_W], u16* score, u16* lines) {
         
         playLineClear(cleared);
         lineClearFlash = 20;
+        PFX_flash(FLASH_COLOR, RGB24_TO_VDPCOLOR(0xFFFFFF), 20, 2);
         
-        // Screen shake based on lines
-        startShake(cleared * 2);
+        // Screen shake based on lines, a ripple out of the well on a 4-LINE
+        if (cleared == 4) {
+            u8 ox = (field == field1) ? 2 : 24;
+            SCRL_ripple(SCRL_LAYERS, (ox + FIELD_W / 2) * 8, (3 + flashY[0]) * 8 + 4, 6, 40);
+        } else {
+            startShake(cleared * 2);
+        }
         
         // Level up every 10 lines
-        if (*lines / 10 >= level) {
+        if (FDIV_DIV10(*lines) >= level) {
             level++;
             dropSpeed = 30 - level * 2;
             if (dropSpeed < 5) dropSpeed = 5;
@@ -280,13 +277,17 @@ static u8 clearLines(u8 field[FIELD_H][FIELD_W], u16* score, u16* lines) {
 
 static void spawnPiece() {
     pieceType = nextPiece;
-    nextPiece = rnd() % 7;
+    nextPiece = RNG_range(RNG_GAME, 7);
     pieceX = 3; pieceY = -2; pieceRot = 0;
     lockDelay = 0;
     hardDropping = 0;
+    wellDirty = 1;
 }
 
 static void initGame(u8 mode) {
+    // The piece sequence depends only on this seed, so a game can be replayed
+    RNG_init(frameCount);
+    INPUT_clear();
     gameMode = mode;
     memset(field1, 0, sizeof(field1));
     memset(field2, 0, sizeof(field2));
@@ -295,33 +296,35 @@ static void initGame(u8 mode) {
     dropSpeed = 30; dropTimer = 0;
     combo = 0;
     lastWasLineClear = 0;
-    nextPiece = rnd() % 7;
+    nextPiece = RNG_range(RNG_GAME, 7);
+    VDP_clearPlane(BG_B, TRUE);  // drop the title text
     spawnPiece();
     currentPlayer = 0;
+    PFX_stop(1);
+    HUD_clear();
+    HUD_drawText("SCORE:", 1, 24);
+    HUD_drawText("LINES:", 16, 24);
+    HUD_drawText("LV:", 28, 24);
+    HUD_drawText("A/B:ROT C:DROP", 13, 26);
+    HUD_show(TRUE);
     gameState = 1;
+    playMusic();
 }
 
-static void update() {
-    u16* score = currentPlayer == 0 ? &score1 : &score2;
-    u16* lines = currentPlayer == 0 ? &lines1 : &lines2;
+// Taps, rotations and hard drops act once per press, so they run once a
+// frame outside the fixed-step update
+static void handleInput() {
+    u32* score = currentPlayer == 0 ? &score1 : &score2;
     u8 (*field)[FIELD_W] = currentPlayer == 0 ? field1 : field2;
-    
-    u16 joy = JOY_readJoypad(currentPlayer == 0 ? JOY_1 : JOY_2);
-    static u16 lastJoy = 0;
-    u16 pressed = joy & ~lastJoy;
-    lastJoy = joy;
-    
-    // Movement with DAS (Delayed Auto Shift feel)
-    if (pressed & BUTTON_LEFT) {
-        if (!checkCollision(field, pieceX-1, pieceY, pieceType, pieceRot)) {
-            pieceX--;
-            playMove();
-            lockDelay = 0;
-        }
-    }
-    if (pressed & BUTTON_RIGHT) {
-        if (!checkCollision(field, pieceX+1, pieceY, pieceType, pieceRot)) {
-            pieceX++;
+    u16 pad = currentPlayer == 0 ? JOY_1 : JOY_2;
+    u16 pressed = INPUT_pressed(pad);
+    
+    // Every queued tap shifts once, even several in one frame
+    u16 dir;
+    while ((dir = INPUT_popDir(pad))) {
+        s8 dx = (dir == BUTTON_LEFT) ? -1 : (dir == BUTTON_RIGHT) ? 1 : 0;
+        if (dx && !checkCollision(field, pieceX + dx, pieceY, pieceType, pieceRot)) {
+            pieceX += dx;
             playMove();
             lockDelay = 0;
         }
@@ -329,7 +332,7 @@ static void update() {
     
     // Rotation
     if (pressed & BUTTON_A) {
-        u8 newRot = (pieceRot + 1) % 4;
+        u8 newRot = (pieceRot + 1) & 3;
         if (!checkCollision(field, pieceX, pieceY, pieceType, newRot)) {
             pieceRot = newRot;
             playRotate();
@@ -350,7 +353,7 @@ static void update() {
     
     // Counter-clockwise rotation
     if (pressed & BUTTON_B) {
-        u8 newRot = (pieceRot + 3) % 4;
+        u8 newRot = (pieceRot + 3) & 3;
         if (!checkCollision(field, pieceX, pieceY, pieceType, newRot)) {
             pieceRot = newRot;
             playRotate();
@@ -358,9 +361,6 @@ static void update() {
         }
     }
     
-    // Soft drop
-    if (joy & BUTTON_DOWN) dropTimer += 5;
-    
     // Hard drop
     if (pressed & BUTTON_C) {
         s8 ghostY = getGhostY(field);
@@ -370,6 +370,16 @@ static void update() {
         playHardDrop();
         startShake(3);
     }
+}
+
+static void update() {
+    u32* score = currentPlayer == 0 ? &score1 : &score2;
+    u16* lines = currentPlayer == 0 ? &lines1 : &lines2;
+    u8 (*field)[FIELD_W] = currentPlayer == 0 ? field1 : field2;
+    u16 joy = INPUT_held(currentPlayer == 0 ? JOY_1 : JOY_2);
+    
+    // Soft drop
+    if (joy & BUTTON_DOWN) dropTimer += 5;
     
     dropTimer++;
     if (dropTimer >= dropSpeed || hardDropping) {
@@ -385,7 +395,11 @@ static void update() {
                 spawnPiece();
                 if (checkCollision(field, pieceX, pieceY, pieceType, pieceRot)) {
                     gameState = 2;
+                    AUD_stopMusic();
                     if (*score > highScore) highScore = *score;
+                    sprintf(finalText[0], "Final Score: %lu", score1);
+                    sprintf(finalText[1], "Lines: %d  Level: %d", lines1, level);
+                    PFX_fade(16, 48, 0, 8, 30);  // Dim the wells under the text
                     playGameOver();
                 }
             }
@@ -396,38 +410,57 @@ static void update() {
     if (lineClearFlash > 0) lineClearFlash--;
 }
 
-static void drawField(u8 field[FIELD_H][FIELD_W], u8 ox) {
-    // Border
-    for (u8 y = 0; y < FIELD_H + 1; y++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BLOCK), ox - 1, 3 + y);
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BLOCK), ox + FIELD_W, 3 + y);
-    }
-    for (u8 x = 0; x < FIELD_W + 2; x++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BLOCK), ox - 1 + x, 3 + FIELD_H);
-    }
+// ============ STATIC WELL (BG_B) ============
+// Frame and locked blocks only change when a piece locks, so they live on
+// BG_B and are redrawn then instead of every frame
+static void drawWell(u8 field[FIELD_H][FIELD_W], u8 ox) {
+    u16 cells[FIELD_H + 1][FIELD_W + 2];
+    u16 border = TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BLOCK);
     
-    // Field
     for (u8 y = 0; y < FIELD_H; y++) {
-        // Check if this line should flash
-        bool flash = FALSE;
-        if (lineClearFlash > 0) {
-            for (u8 i = 0; i < flashCount; i++) {
-                if (flashY[i] == y && frameCount % 4 < 2) {
-                    flash = TRUE;
-                    break;
-                }
+        cells[y][0] = border;
+        cells[y][FIELD_W + 1] = border;
+        for (u8 x = 0; x < FIELD_W; x++) {
+            u16 tile = 0;
+            if (field[y][x]) {
+                // Cells hold pieceType + 1
+                u8 pal = PIECE_COLORS[field[y][x] - 1];
+                tile = TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BLOCK);
             }
+            cells[y][x + 1] = tile;
         }
-        
-        for (u8 x = 0; x < FIELD_W; x++) {
+    }
+    for (u8 x = 0; x < FIELD_W + 2; x++) {
+        cells[FIELD_H][x] = border;
+    }
+    
+    VDP_setTileMapDataRect(BG_B, &cells[0][0], ox - 1, 3, FIELD_W + 2, FIELD_H + 1, FIELD_W + 2, CPU);
+}
+
+static void drawNextPiece(u8 ox) {
+    VDP_drawTextBG(BG_B, "NEXT", ox, 1);
+    
+    u16 shape = PIECES[nextPiece][0];
+    u8 pal = PIECE_COLORS[nextPiece];
+    for (s8 y = 0; y < 4; y++) {
+        for (s8 x = 0; x < 4; x++) {
             u16 tile = 0;
-            if (flash) {
-                tile = TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BLOCK);
-            } else if (field[y][x]) {
-                u8 pal = PIECE_COLORS[(field[y][x] - 1) % 7];
+            if (shape & (0x8000 >> (y * 4 + x))) {
                 tile = TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BLOCK);
             }
-            VDP_setTileMapXY(BG_A, tile, ox + x, 3 + y);
+            VDP_setTileMapXY(BG_B, tile, ox + x, 2 + y);
+        }
+    }
+}
+
+// Moving parts only: flashing lines, ghost and falling piece
+static void drawField(u8 field[FIELD_H][FIELD_W], u8 ox) {
+    // Line clear flash
+    if (lineClearFlash > 0) {
+        for (u8 i = 0; i < flashCount; i++) {
+            for (u8 x = 0; x < FIELD_W; x++) {
+                TMAP_setTile(TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_FLASH), ox + x, 3 + flashY[i]);
+            }
         }
     }
     
@@ -439,8 +472,8 @@ static void drawField(u8 field[FIELD_H][FIELD_W], u8 ox) {
             for (s8 x = 0; x < 4; x++) {
                 if (shape & (0x8000 >> (y * 4 + x))) {
                     if (ghostY + y >= 0)
-                        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_GHOST), 
-                                        ox + pieceX + x, 3 + ghostY + y);
+                        TMAP_setTile(TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_GHOST),
+                                     ox + pieceX + x, 3 + ghostY + y);
                 }
             }
         }
@@ -453,151 +486,154 @@ static void drawField(u8 field[FIELD_H][FIELD_W], u8 ox) {
         for (s8 x = 0; x < 4; x++) {
             if (shape & (0x8000 >> (y * 4 + x))) {
                 if (pieceY + y >= 0)
-                    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BLOCK), 
-                                    ox + pieceX + x, 3 + pieceY + y);
+                    TMAP_setTile(TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BLOCK),
+                                 ox + pieceX + x, 3 + pieceY + y);
             }
         }
     }
 }
 
-static void drawNextPiece(u8 ox) {
-    VDP_drawText("NEXT", ox, 1);
-    
-    u16 shape = PIECES[nextPiece][0];
-    u8 pal = PIECE_COLORS[nextPiece];
-    for (s8 y = 0; y < 4; y++) {
-        for (s8 x = 0; x < 4; x++) {
-            u16 tile = 0;
-            if (shape & (0x8000 >> (y * 4 + x))) {
-                tile = TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BLOCK);
-            }
-            VDP_setTileMapXY(BG_A, tile, ox + x, 2 + y);
-        }
-    }
-}
-
 static void draw() {
-    VDP_clearPlane(BG_A, TRUE);
+    if (wellDirty) {
+        drawWell(field1, 2);
+        if (gameMode == 1) drawWell(field2, 24);
+        drawNextPiece(14);
+        wellDirty = 0;
+    }
+    
+    TMAP_clear();
     drawField(field1, 2);
-    drawNextPiece(14);
     
     if (gameMode == 1) {
         drawField(field2, 24);
     }
     
     // HUD
-    char buf[20];
-    sprintf(buf, "SCORE:%d", score1);
-    VDP_drawText(buf, 14, 8);
-    
-    sprintf(buf, "LINES:%d", lines1);
-    VDP_drawText(buf, 14, 10);
-    
-    sprintf(buf, "LV:%d", level);
-    VDP_drawText(buf, 14, 12);
+    HUD_setCounter(HUD_SCORE, score1);
+    HUD_setCounter(HUD_LINES, lines1);
+    HUD_setCounter(HUD_LEVEL, level);
     
     // Combo display
     if (combo > 0) {
-        sprintf(buf, "COMBO x%d!", combo);
-        VDP_drawText(buf, 14, 14);
+        HUD_drawText("COMBO x", 1, 25);
+        HUD_setCounter(HUD_COMBO, combo);
+    } else {
+        HUD_clearText(1, 25, 7);
+        HUD_hideCounter(HUD_COMBO);
     }
     
     // Sound indicator
-    VDP_drawText(soundEnabled ? "SND" : "---", 14, 24);
-    
-    // Controls hint
-    VDP_drawText("A/B:ROT C:DROP", 13, 26);
+    HUD_drawText(soundEnabled ? "SND" : "---", 36, 24);
 }
 
-static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    titleFrame++;
+// Static title text, sent to BG_B once on entering the title
+static const ScreenText titleScreen[] = {
+    // Standard title block
+    { 10,  3, "====================" },
+    { 10,  4, "   BATTLE 4TRIS    " },
+    { 10,  5, "====================" },
+    { 12,  7, "Free Retro Games" },
+    { 17,  8, "v1.0.0" },
     
-    // Pulsing title color
-    if (titleFrame % 20 < 10) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFF00FF));
-    }
+    // Player select
+    { 10, 18, "--------------------" },
+    { 12, 20, "START - 1 Player" },
+    { 12, 22, "    A - 2 Players" },
+    { 10, 24, "--------------------" },
     
-    // Standard title block
-    VDP_drawText("====================", 10, 3);
-    VDP_drawText("   BATTLE 4TRIS    ", 10, 4);
-    VDP_drawText("====================", 10, 5);
-    VDP_drawText("Free Retro Games", 12, 7);
-    VDP_drawText("v1.0.0", 17, 8);
+    // Sound toggle and high score
+    { 13, 26, hiScoreText },
+    {  2, 27, "C:Sound" },
+    
+    // Footer
+    { 22, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+// Static text is in titleScreen, only what moves or toggles is drawn here
+static void drawTitle(void) {
+    TMAP_clear();
     
     // Animated falling piece
-    u8 animPieceY = (titleFrame / 6) % 8;
-    u8 animPieceType = (titleFrame / 30) % 7;
-    u16 shape = PIECES[animPieceType][0];
+    if (titleTimer) titleTimer--;
+    else {
+        titleTimer = 5;
+        titlePieceY = (titlePieceY + 1) & 7;
+        if (titlePieceY == 0) titlePieceType = (titlePieceType == 6) ? 0 : titlePieceType + 1;
+    }
+    u16 shape = PIECES[titlePieceType][0];
     for (s8 y = 0; y < 4; y++) {
         for (s8 x = 0; x < 4; x++) {
             if (shape & (0x8000 >> (y * 4 + x))) {
-                VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PIECE_COLORS[animPieceType], 0, 0, 0, TILE_BLOCK), 
-                                18 + x, 10 + animPieceY + y);
+                TMAP_setTile(TILE_ATTR_FULL(PIECE_COLORS[titlePieceType], 0, 0, 0, TILE_BLOCK),
+                             18 + x, 10 + titlePieceY + y);
             }
         }
     }
     
-    // Player select
-    VDP_drawText("--------------------", 10, 18);
-    VDP_drawText("START - 1 Player", 12, 20);
-    VDP_drawText("    A - 2 Players", 12, 22);
-    VDP_drawText("--------------------", 10, 24);
-    
-    // Sound toggle and high score
-    char buf[24];
-    sprintf(buf, "High Score: %d", highScore);
-    VDP_drawText(buf, 13, 26);
-    
-    VDP_drawText("C:Sound", 2, 27);
-    VDP_drawText(soundEnabled ? "[ON]" : "[OFF]", 2, 28);
-    
-    // Footer
-    VDP_drawText("(C) 2026 monteslu", 22, 27);
+    // Sound toggle
+    TMAP_drawText(soundEnabled ? "[ON]" : "[OFF]", 2, 28);
 }
 
 static void drawGameOver() {
     draw();
     
-    if (frameCount % 10 < 5) {
-        VDP_drawText("=== GAME OVER ===", 11, 12);
+    if (FDIV_MOD10(frameCount) < 5) {
+        TMAP_drawText("=== GAME OVER ===", 11, 12);
     }
     
-    char buf[24];
-    sprintf(buf, "Final Score: %d", score1);
-    VDP_drawText(buf, 12, 14);
-    
-    sprintf(buf, "Lines: %d  Level: %d", lines1, level);
-    VDP_drawText(buf, 10, 16);
+    TMAP_drawText(finalText[0], 12, 14);
+    TMAP_drawText(finalText[1], 10, 16);
     
     if (score1 >= highScore && score1 > 0) {
-        VDP_drawText("*** NEW HIGH SCORE! ***", 8, 18);
+        TMAP_drawText("*** NEW HIGH SCORE! ***", 8, 18);
     }
     
-    VDP_drawText("Press START", 14, 22);
+    TMAP_drawText("Press START", 14, 22);
 }
 
+// Well redraw for the cycle benchmark, 100 cells filled: each cell's
+// colour no longer goes through % 7
+static const BenchProfile benchProfile = { 100, 0, 0, 0, 0 };
+
 int main() {
     VDP_setScreenWidth320();
     PAL_setColor(0, RGB24_TO_VDPCOLOR(0x000000));
     PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
+    PAL_setColor(FLASH_COLOR, RGB24_TO_VDPCOLOR(0x444444));
     
     // Block colors
     PAL_setColor(17, RGB24_TO_VDPCOLOR(0x00FFFF)); // Cyan (I)
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0xFFFF00)); // Yellow (O, L)
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0xFF00FF)); // Magenta (T, Z)
     
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("BATTLE 4TRIS", &benchProfile);
+    
+    RNG_init(12345);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    TMAP_init(BG_A, TMAP_DOUBLE_BUFFER);
+    HUD_init(TRUE, 4);
+    HUD_setupCounter(HUD_SCORE, 7, 24, 7, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LINES, 22, 24, 5, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LEVEL, 31, 24, 3, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_COMBO, 8, 25, 3, HUD_ALIGN_LEFT);
+    sprintf(hiScoreText, "High Score: %lu", highScore);
     gameState = 0;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFF00FF), 20);  // Pulsing title color
+    SCRN_load(BG_B, titleScreen);
     drawTitle();
     
-    u16 lastJoy = 0;
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy; seed += frameCount;
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
         
         if (gameState == 0) {
             if (pressed & BUTTON_START) {
@@ -612,24 +648,29 @@ int main() {
                 soundEnabled = !soundEnabled;
                 playMenuBlip();
             }
-            drawTitle();
+            // A new state has drawn its own screen already
+            if (gameState == 0) drawTitle();
         } else if (gameState == 1) {
-            update();
-            updateShake();
-            updateSound();
+            handleInput();
+            while (ticks-- && gameState == 1) update();
             draw();
         } else {
             drawGameOver();
-            updateSound();
             if (pressed & BUTTON_START) {
                 playMenuBlip();
                 gameState = 0;
-                VDP_clearPlane(BG_A, TRUE);
+                HUD_show(FALSE);
+                PFX_stopAll();
+                PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFF00FF), 20);
+                sprintf(hiScoreText, "High Score: %lu", highScore);
+                SCRN_load(BG_B, titleScreen);
                 drawTitle();
             }
         }
         frameCount++;
+        TMAP_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     return 0;
 }
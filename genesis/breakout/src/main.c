@@ -4,12 +4,40 @@
  */
 
 #include <genesis.h>
+#include "resources.h"
 
-#define TILE_EMPTY   0
-#define TILE_PADDLE  1
-#define TILE_BALL    2
-#define TILE_BRICK   3
-#define TILE_SPARK   4
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/fastdiv.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/kinematics.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/particles.h"
+#include "common/rng.h"
+#include "common/sched.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/sprites.h"
+#include "common/sweep.h"
+#include "common/tileanim.h"
+#include "common/tilemap.h"
+#include "common/trig.h"
+#include "common/vram.h"
+
+#define TILE_EMPTY   (gameTiles + 0)
+#define TILE_PADDLE  (gameTiles + 1)
+#define TILE_BALL    (gameTiles + 2)
+#define TILE_BRICK   (gameTiles + 3)
+#define TILE_SPARK   (gameTiles + 4)
+#define TILE_BRICK_FLASH (gameTiles + 5)
+#define TILE_DEBRIS  (gameTiles + 6)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
 
 #define ARENA_W      40
 #define ARENA_H      28
@@ -17,8 +45,28 @@
 #define BRICKS_H     6
 #define BRICK_X      10
 
-static s16 paddleX, ballX, ballY;
-static s8 ballDX, ballDY;
+// Pixel bounds: the ball stays below the HUD, the paddle sits on row ARENA_H - 2
+#define WALL_TOP     16
+#define WALL_RIGHT   ((ARENA_W - 1) * 8)
+#define PADDLE_TOP   ((ARENA_H - 2) * 8)
+#define PADDLE_W     5
+#define PADDLE_PX    (PADDLE_W * 8)
+
+// Paddle top speed and acceleration, pixels per frame
+#define PADDLE_SPEED FIX16(7)
+#define PADDLE_ACCEL FIX16(1.5)
+
+// CRAM entries flashed on hits
+#define PADDLE_COLOR 33
+#define BRICK_FLASH_INDEX 4   // colour index of TILE_BRICK_FLASH in each brick palette
+
+// HUD counters (top two rows, above the ball's reach)
+#define HUD_SCORE    0
+#define HUD_LEVEL    1
+#define HUD_LIVES    2
+#define HUD_COMBO    3
+
+static KinBody paddle, ball;
 static u8 bricks[BRICKS_H][BRICKS_W];
 static u8 lives, bricksLeft;
 static u16 score;
@@ -27,143 +75,142 @@ static u16 frameCount;
 
 // PIZZAZZ!
 static u8 soundEnabled = 1;
-static s16 shakeX = 0, shakeY = 0;
-static u8 shakeTimer = 0;
 static u16 highScore = 0;
-static u8 titleFrame = 0;
+static bool newHighScore = FALSE;
+// Formatted once per state change rather than every frame
+static char hiScoreText[24];
+static char finalText[2][24];
+static u8 titleBallX = 0;        // title ball, steps every 3 frames
+static u8 titleTimer = 0;
 static u8 combo = 0;
 static u8 comboTimer = 0;
 static u8 level = 1;
-static u8 ballSpeed = 1;
-static u8 paddleFlash = 0;
-static u8 sparkX, sparkY, sparkTimer = 0;
+static u8 ballSpeed = 0;     // index into ballSpeeds
+static u16 sparkAnim;
 static u8 brickFlashX, brickFlashY, brickFlashTimer = 0;
-static s16 ball2X, ball2Y;
-static s8 ball2DX, ball2DY;
+static KinBody ball2;
 static u8 ball2Active = 0;
 
-static u16 seed = 12345;
-static u16 rnd() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7FFF; }
+// Ball speed, going up with the score
+static const fix16 ballSpeeds[3] = { FIX16(4), FIX16(5.5), FIX16(7) };
 
 // ============ SOUND EFFECTS ============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+static const SfxStep bounceSteps[] = { { 600, 13, 4, 0, 1 }, SFX_END };
+static const SfxStep brickSteps[] = { { 800, 14, 5, 0, 1 }, SFX_END };
+static const SfxStep paddleSteps[] = { { 400, 14, 4, 0, 1 }, SFX_END };
+static const SfxStep loseLifeSteps[] = {
+    { 300, 15, 6, 0, 0 }, { 250, 15, 6, 0, 0 }, { 200, 15, 6, 0, 0 }, { 150, 15, 12, 0, 1 }, SFX_END
+};
+static const SfxStep levelUpSteps[] = {
+    { 600, 15, 4, 0, 0 }, { 750, 15, 4, 0, 0 }, { 900, 15, 4, 0, 0 }, { 1050, 15, 10, 0, 1 }, SFX_END
+};
+static const SfxStep comboSteps[] = { { 1200, 14, 6, 0, 1 }, SFX_END };
+static const SfxStep blipSteps[] = { { 1000, 12, 3, 0, 1 }, SFX_END };
+
+static const Sfx sfxBounce = { SFX_PRIO_LOW, FALSE, bounceSteps };
+static const Sfx sfxBrick = { SFX_PRIO_MID, FALSE, brickSteps };
+static const Sfx sfxPaddle = { SFX_PRIO_LOW, FALSE, paddleSteps };
+static const Sfx sfxLoseLife = { SFX_PRIO_JINGLE, FALSE, loseLifeSteps };
+static const Sfx sfxLevelUp = { SFX_PRIO_JINGLE, FALSE, levelUpSteps };
+static const Sfx sfxCombo = { SFX_PRIO_HIGH, FALSE, comboSteps };
+static const Sfx sfxBlip = { SFX_PRIO_LOW, FALSE, blipSteps };
+
 static void playBounce() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 600 + combo * 50);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 5);
+    SFX_playPitch(&sfxBounce, combo * 50);
 }
 
 static void playBrickHit() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 800 + (rnd() % 200));
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 6);
+    SFX_playPitch(&sfxBrick, RNG_range(RNG_FX, 200));
 }
 
 static void playPaddleHit() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 400);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 4);
+    SFX_play(&sfxPaddle);
 }
 
 static void playLoseLife() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 300 - i * 50);
-        for (u16 j = 0; j < 4000; j++) {}
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
+    AUD_PLAY_PCM(impact_pcm, SFX_PRIO_JINGLE);
+    SFX_play(&sfxLoseLife);
 }
 
 static void playLevelUp() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 600 + i * 150);
-        for (u16 j = 0; j < 2500; j++) {}
-    }
+    SFX_play(&sfxLevelUp);
 }
 
 static void playCombo() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1200 + combo * 100);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 3);
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 1500 + combo * 100);
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 3);
+    SFX_playPitch(&sfxCombo, combo * 100);
+    SFX_playPitch(&sfxCombo, 300 + combo * 100);
 }
 
 static void playMenuBlip() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1000);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 2);
+    SFX_play(&sfxBlip);
 }
 
-static void updateSound() {
-    static u8 fadeTimer = 0;
-    fadeTimer++;
-    if (fadeTimer > 3) {
-        fadeTimer = 0;
-        for (u8 ch = 0; ch < 4; ch++) {
-            PSG_setEnvelope(ch, PSG_ENVELOPE_MIN);
-        }
-    }
+// Background track, on the Z80 for the whole game
+static void playMusic() {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============ SCREEN SHAKE ============
 static void startShake(u8 intensity) {
-    shakeTimer = intensity;
-}
-
-static void updateShake() {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeY = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeTimer--;
-    } else {
-        shakeX = shakeY = 0;
-    }
-    VDP_setHorizontalScroll(BG_A, shakeX);
-    VDP_setVerticalScroll(BG_A, shakeY);
+    SCRL_shake(SCRL_LAYERS, intensity, intensity);
 }
 
-static void spawnSpark(u8 x, u8 y) {
-    sparkX = x;
-    sparkY = y;
-    sparkTimer = 8;
+static void spawnSpark(s16 x, s16 y) {
+    PART_spawn(x, y, 0, 0, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_SPARK), 8, 0);
+    TANIM_play(sparkAnim);
 }
 
 static void createTiles() {
-    u32 td[8];
-    memset(td, 0, 32); VDP_loadTileData(td, TILE_EMPTY, 1, CPU);
-    memset(td, 0x11, 32); VDP_loadTileData(td, TILE_PADDLE, 1, CPU);
-    memset(td, 0x22, 32); VDP_loadTileData(td, TILE_BALL, 1, CPU);
-    memset(td, 0x33, 32); VDP_loadTileData(td, TILE_BRICK, 1, CPU);
-    
-    // Spark
-    memset(td, 0, 32);
-    td[1] = 0x00200200;
-    td[2] = 0x02020020;
-    td[3] = 0x00222200;
-    td[4] = 0x00222200;
-    td[5] = 0x02020020;
-    td[6] = 0x00200200;
-    VDP_loadTileData(td, TILE_SPARK, 1, CPU);
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
+    
+    // Spark (one-shot, replayed on every hit)
+    sparkAnim = TANIM_add(TILE_SPARK, spark_anim.tiles, spark_anim.numTile, 3, FALSE);
 }
 
 static void resetBall() {
-    ballX = paddleX + 2;
-    ballY = ARENA_H - 4;
-    ballDX = (rnd() % 2) ? 1 : -1;
-    ballDY = -1;
-    ballSpeed = 1;
+    KIN_set(&ball, KIN_X(&paddle) + PADDLE_PX / 2 - 4, (ARENA_H - 4) * 8, 0, 0);
+    // Up and to one side
+    u8 angle = RNG_range(RNG_GAME, 2) ? TRIG_UP + 32 : TRIG_UP - 32;
+    TRIG_polar(angle, ballSpeeds[ballSpeed], &ball.vx, &ball.vy);
     combo = 0;
 }
 
+// ============ BRICK WALL (BG_B) ============
+// The wall only changes when a brick is hit, so it lives on BG_B and is
+// updated a cell at a time instead of being redrawn every frame
+// Palette of a brick by hits left (hits % 3 + 1), a brick has at most
+// BRICKS_H + 2 hits
+static const u8 brickPal[BRICKS_H + 3] = { 1, 2, 3, 1, 2, 3, 1, 2, 3 };
+
+static u16 brickTile(u8 hits) {
+    if (hits == 0) return 0;
+    return TILE_ATTR_FULL(brickPal[hits], 0, 0, 0, TILE_BRICK);
+}
+
+static void drawBrick(u8 x, u8 y) {
+    VDP_setTileMapXY(BG_B, brickTile(bricks[y][x]), BRICK_X + x, 3 + y);
+}
+
+static void drawBricks() {
+    u16 wall[BRICKS_H][BRICKS_W];
+    for (u8 y = 0; y < BRICKS_H; y++) {
+        for (u8 x = 0; x < BRICKS_W; x++) {
+            wall[y][x] = brickTile(bricks[y][x]);
+        }
+    }
+    VDP_setTileMapDataRect(BG_B, &wall[0][0], BRICK_X, 3, BRICKS_W, BRICKS_H, BRICKS_W, CPU);
+}
+
 static void setupLevel() {
     bricksLeft = 0;
     for (u8 y = 0; y < BRICKS_H; y++) {
@@ -177,151 +224,184 @@ static void setupLevel() {
             bricksLeft++;
         }
     }
+    drawBricks();
 }
 
 static void initGame() {
+    // Serves depend only on this seed, so a game can be replayed
+    RNG_init(frameCount);
     lives = 3; 
     score = 0;
     level = 1;
     combo = 0;
     comboTimer = 0;
     ball2Active = 0;
-    paddleX = ARENA_W / 2 - 2;
+    ballSpeed = 0;
+    KIN_set(&paddle, (ARENA_W / 2 - 2) * 8, PADDLE_TOP, 0, 0);
     
+    VDP_clearPlane(BG_B, TRUE);  // drop the title text
     setupLevel();
     resetBall();
+    PART_clear();
+    PFX_stop(1);
+    HUD_clear();
+    HUD_drawText("SCORE:", 1, 0);
+    HUD_drawText("LV:", 16, 0);
+    HUD_drawText("LIVES:", 24, 0);
+    HUD_show(TRUE);
     gameState = 1;
+    playMusic();
 }
 
-static void processBallPhysics(s16* bx, s16* by, s8* bdx, s8* bdy) {
-    *bx += *bdx;
-    *by += *bdy;
+// Sweep callback: screen cell holds a brick that is still standing
+static bool isBrick(s16 x, s16 y) {
+    s16 bx = x - BRICK_X, by = y - 3;
+    return bx >= 0 && bx < BRICKS_W && by >= 0 && by < BRICKS_H && bricks[by][bx] > 0;
+}
+
+static void processBallPhysics(KinBody* b) {
+    fix16 lastY = b->y;
+    
+    // Move, bouncing off the first brick on the way however fast we go
+    SweepHit hit;
+    bool hitBrick = SWEEP_move(b, 4, isBrick, &hit, TRUE);
+    s16 x = KIN_X(b), y = KIN_Y(b);
     
     // Wall bounces
-    if (*bx <= 0) { 
-        *bdx = 1; 
+    if (x <= 0 && b->vx < 0) { 
+        b->vx = -b->vx; 
         playBounce();
-        spawnSpark(*bx, *by);
+        spawnSpark(0, y);
     }
-    if (*bx >= ARENA_W - 1) { 
-        *bdx = -1; 
+    if (x >= WALL_RIGHT && b->vx > 0) { 
+        b->vx = -b->vx; 
         playBounce();
-        spawnSpark(*bx, *by);
+        spawnSpark(WALL_RIGHT, y);
     }
-    if (*by <= 2) { 
-        *bdy = 1; 
+    if (y <= WALL_TOP && b->vy < 0) { 
+        b->vy = -b->vy; 
         playBounce();
-        spawnSpark(*bx, *by);
+        spawnSpark(x, WALL_TOP);
     }
     
-    // Paddle collision
-    if (*by == ARENA_H - 3 && *bx >= paddleX && *bx < paddleX + 5) {
-        *bdy = -1;
+    // Paddle collision: the ball's bottom edge crossed the paddle top
+    s16 px = KIN_X(&paddle);
+    if (fix16ToInt(lastY) + 8 <= PADDLE_TOP && y + 8 > PADDLE_TOP &&
+        x + 8 > px && x < px + PADDLE_PX) {
+        b->y = intToFix16(PADDLE_TOP - 8);
         
-        // Angle based on hit position
-        s8 hitPos = *bx - paddleX - 2;
-        *bdx = hitPos;
-        if (*bdx == 0) *bdx = (rnd() % 2) ? 1 : -1;
+        // Angle based on hit position, up to about 50 degrees off vertical;
+        // dead centre still leans a little so the ball can't stick
+        s16 hitPos = (x + 4) - (px + PADDLE_PX / 2);
+        if (hitPos == 0) hitPos = RNG_range(RNG_GAME, 2) ? 2 : -2;
+        TRIG_polar(TRIG_UP + hitPos + (hitPos >> 1), ballSpeeds[ballSpeed], &b->vx, &b->vy);
         
         playPaddleHit();
-        paddleFlash = 6;
-        spawnSpark(*bx, *by);
+        PFX_flash(PADDLE_COLOR, RGB24_TO_VDPCOLOR(0xFFFFFF), 6, 1);
+        spawnSpark(x, PADDLE_TOP - 8);
         
         // Reset combo on paddle hit
         combo = 0;
     }
     
     // Brick collision
-    if (*by >= 3 && *by < 3 + BRICKS_H) {
-        s16 brickX = *bx - BRICK_X;
-        s16 brickY = *by - 3;
-        if (brickX >= 0 && brickX < BRICKS_W && bricks[brickY][brickX] > 0) {
-            bricks[brickY][brickX]--;
+    if (hitBrick) {
+        s16 brickX = hit.cellX - BRICK_X;
+        s16 brickY = hit.cellY - 3;
+        u16 pal = brickPal[bricks[brickY][brickX]];
+        bricks[brickY][brickX]--;
+        drawBrick(brickX, brickY);
+        
+        if (bricks[brickY][brickX] == 0) {
+            bricksLeft--;
+            
+            // Chips in the brick's colour, thrown up and falling away
+            PART_burst((BRICK_X + brickX) * 8, (3 + brickY) * 8, 6, FIX16(1.5),
+                       TILE_ATTR_FULL(pal, 0, 0, 0, TILE_DEBRIS), 40, PART_SPRITE | PART_GRAVITY);
             
-            if (bricks[brickY][brickX] == 0) {
-                bricksLeft--;
-                
-                // Combo!
-                if (comboTimer > 0) {
-                    combo++;
-                    if (combo >= 3) {
-                        playCombo();
-                        startShake(combo > 5 ? 4 : 2);
-                    }
-                } else {
-                    combo = 1;
+            // Combo!
+            if (comboTimer > 0) {
+                combo++;
+                if (combo >= 3) {
+                    playCombo();
+                    startShake(combo > 5 ? 4 : 2);
                 }
-                comboTimer = 30;
-                
-                // Score with combo multiplier
-                u16 points = (BRICKS_H - brickY) * 10 * (1 + combo / 2);
-                score += points;
+            } else {
+                combo = 1;
             }
+            comboTimer = 60;
             
-            brickFlashX = BRICK_X + brickX;
-            brickFlashY = 3 + brickY;
-            brickFlashTimer = 6;
-            
-            *bdy = -*bdy;
-            playBrickHit();
-            startShake(1);
-            
-            // Easter egg: 10+ combo spawns second ball!
-            if (combo == 10 && !ball2Active) {
-                ball2Active = 1;
-                ball2X = *bx;
-                ball2Y = *by;
-                ball2DX = -*bdx;
-                ball2DY = -*bdy;
-                startShake(6);
-            }
+            // Score with combo multiplier
+            u16 points = (BRICKS_H - brickY) * 10 * (1 + combo / 2);
+            score += points;
+        }
+        
+        brickFlashX = BRICK_X + brickX;
+        brickFlashY = 3 + brickY;
+        brickFlashTimer = 6;
+        if (bricks[brickY][brickX] > 0) {
+            u16 entry = brickPal[bricks[brickY][brickX]] * 16 + BRICK_FLASH_INDEX;
+            PFX_flash(entry, RGB24_TO_VDPCOLOR(0xFFFFFF), 6, 1);
+        }
+        
+        playBrickHit();
+        startShake(1);
+        
+        // Easter egg: 10+ combo spawns second ball!
+        if (combo == 10 && !ball2Active) {
+            ball2Active = 1;
+            KIN_set(&ball2, KIN_X(b), KIN_Y(b), -b->vx, -b->vy);
+            startShake(6);
         }
     }
 }
 
 static void update() {
-    u16 joy = JOY_readJoypad(JOY_1);
-    
-    // Faster paddle
-    if (joy & BUTTON_LEFT) paddleX -= 3;
-    if (joy & BUTTON_RIGHT) paddleX += 3;
-    if (paddleX < 1) paddleX = 1;
-    if (paddleX > ARENA_W - 5) paddleX = ARENA_W - 5;
-    
-    // Speed ramping
-    u8 speed = ballSpeed;
-    if (score > 500) speed = 2;
-    if (score > 1500) speed = 3;
-    
-    for (u8 s = 0; s < speed; s++) {
-        processBallPhysics(&ballX, &ballY, &ballDX, &ballDY);
+    u16 joy = INPUT_held(JOY_1);
+    
+    // Paddle speeds up while held and slides to a stop
+    fix16 target = 0;
+    if (joy & BUTTON_LEFT) target = -PADDLE_SPEED;
+    if (joy & BUTTON_RIGHT) target = PADDLE_SPEED;
+    paddle.vx = KIN_approach(paddle.vx, target, PADDLE_ACCEL);
+    KIN_step(&paddle);
+    KIN_clampX(&paddle, 8, (ARENA_W - PADDLE_W) * 8);
+    
+    // Speed ramping, picked up on the next paddle hit
+    ballSpeed = 0;
+    if (score > 500) ballSpeed = 1;
+    if (score > 1500) ballSpeed = 2;
+    
+    processBallPhysics(&ball);
+    if (ball2Active) {
+        processBallPhysics(&ball2);
         
-        if (ball2Active) {
-            processBallPhysics(&ball2X, &ball2Y, &ball2DX, &ball2DY);
-            
-            // Ball 2 out of bounds
-            if (ball2Y >= ARENA_H - 1) {
-                ball2Active = 0;
-            }
+        // Ball 2 out of bounds
+        if (KIN_Y(&ball2) >= (ARENA_H - 1) * 8) {
+            ball2Active = 0;
         }
     }
     
     // Ball out of bounds
-    if (ballY >= ARENA_H - 1) {
+    if (KIN_Y(&ball) >= (ARENA_H - 1) * 8) {
         if (ball2Active) {
             // Switch to ball 2
-            ballX = ball2X;
-            ballY = ball2Y;
-            ballDX = ball2DX;
-            ballDY = ball2DY;
+            ball = ball2;
             ball2Active = 0;
         } else {
             lives--;
             playLoseLife();
-            startShake(8);
+            SCRL_wobble(SCRL_LAYERS, 6, 45);
             
             if (lives == 0) {
                 gameState = 2;
+                AUD_stopMusic();
+                PART_clear();
+                sprintf(finalText[0], "Final Score: %d", score);
+                sprintf(finalText[1], "Level Reached: %d", level);
+                newHighScore = score > highScore;
+                if (newHighScore) highScore = score;
+                PFX_fade(16, 48, 0, 8, 30);  // Dim the playfield under the text
             } else {
                 resetBall();
             }
@@ -349,137 +429,121 @@ static void update() {
 }
 
 static void draw() {
-    VDP_clearPlane(BG_A, TRUE);
-    
-    // Bricks with flash effects
-    for (u8 y = 0; y < BRICKS_H; y++) {
-        for (u8 x = 0; x < BRICKS_W; x++) {
-            if (bricks[y][x] > 0) {
-                u8 pal = (bricks[y][x] % 3) + 1;
-                
-                // Flash effect on hit brick
-                if (brickFlashTimer > 0 && 
-                    brickFlashX == BRICK_X + x && 
-                    brickFlashY == 3 + y &&
-                    frameCount % 2) {
-                    pal = PAL0;
-                }
-                
-                VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal, 0, 0, 0, TILE_BRICK), BRICK_X + x, 3 + y);
-            }
+    TMAP_clear();
+    
+    // Flash effect on hit brick (drawn over the wall on BG_B)
+    if (brickFlashTimer > 0) {
+        // Blinking is done on the flash tile's palette entry
+        u8 hits = bricks[brickFlashY - 3][brickFlashX - BRICK_X];
+        if (hits > 0) {
+            TMAP_setTile(TILE_ATTR_FULL(brickPal[hits], 0, 0, 0, TILE_BRICK_FLASH), brickFlashX, brickFlashY);
         }
+        brickFlashTimer--;
     }
-    if (brickFlashTimer > 0) brickFlashTimer--;
     
-    // Paddle with flash
-    u8 paddlePal = (paddleFlash > 0 && frameCount % 2) ? PAL0 : PAL2;
+    // Paddle (hit flash is on its palette entry)
     for (u8 i = 0; i < 5; i++)
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(paddlePal, 0, 0, 0, TILE_PADDLE), paddleX + i, ARENA_H - 2);
-    if (paddleFlash > 0) paddleFlash--;
+        SPRL_add(KIN_X(&paddle) + i * 8, PADDLE_TOP, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_PADDLE), TRUE);
     
-    // Ball(s)
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), ballX, ballY);
+    // Ball(s), never flickered out
+    SPRL_add(KIN_X(&ball), KIN_Y(&ball), SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), TRUE);
     if (ball2Active) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_BALL), ball2X, ball2Y);
+        SPRL_add(KIN_X(&ball2), KIN_Y(&ball2), SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_BALL), TRUE);
     }
     
-    // Spark
-    if (sparkTimer > 0) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_SPARK), sparkX, sparkY);
-        sparkTimer--;
-    }
+    // Sparks and brick debris
+    PART_draw();
     
     // HUD
-    char buf[24];
-    sprintf(buf, "SCORE:%d", score);
-    VDP_drawText(buf, 1, 0);
-    
-    sprintf(buf, "LV:%d", level);
-    VDP_drawText(buf, 16, 0);
-    
-    sprintf(buf, "LIVES:%d", lives);
-    VDP_drawText(buf, 24, 0);
+    HUD_setCounter(HUD_SCORE, score);
+    HUD_setCounter(HUD_LEVEL, level);
+    HUD_setCounter(HUD_LIVES, lives);
     
     // Combo display
     if (combo > 1) {
-        sprintf(buf, "x%d!", combo);
-        VDP_drawText(buf, 35, 0);
+        HUD_drawText("x", 35, 0);
+        HUD_setCounter(HUD_COMBO, combo);
+    } else {
+        HUD_clearText(35, 0, 1);
+        HUD_hideCounter(HUD_COMBO);
     }
     
     // Multiball indicator
     if (ball2Active) {
-        VDP_drawText("MULTI!", 1, 1);
+        HUD_drawText("MULTI!", 1, 1);
+    } else {
+        HUD_clearText(1, 1, 6);
     }
     
     // Sound indicator
-    VDP_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H - 1);
+    TMAP_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H - 1);
 }
 
-static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    titleFrame++;
-    
-    // Pulsing title color
-    if (titleFrame % 20 < 10) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFF8888));
-    }
-    
+// Static title text, sent to BG_B once on entering the title
+static const ScreenText titleScreen[] = {
     // Standard title block
-    VDP_drawText("====================", 10, 4);
-    VDP_drawText("     BREAKOUT       ", 10, 5);
-    VDP_drawText("====================", 10, 6);
-    VDP_drawText("Free Retro Games", 12, 8);
-    VDP_drawText("v1.0.0", 17, 9);
-    
-    // Demo bricks and ball
-    for (u8 x = 12; x < 28; x++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1 + (x % 3), 0, 0, 0, TILE_BRICK), x, 11);
-    }
-    u8 ballAnimX = 15 + (titleFrame / 3) % 10;
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), ballAnimX, 13);
+    { 10,  4, "====================" },
+    { 10,  5, "     BREAKOUT       " },
+    { 10,  6, "====================" },
+    { 12,  8, "Free Retro Games" },
+    { 17,  9, "v1.0.0" },
     
     // Player select (1P only for Breakout)
-    VDP_drawText("--------------------", 10, 15);
-    VDP_drawText("START - Play Game", 12, 17);
-    VDP_drawText("--------------------", 10, 19);
+    { 10, 15, "--------------------" },
+    { 12, 17, "START - Play Game" },
+    { 10, 19, "--------------------" },
     
     // High score
-    char buf[24];
-    sprintf(buf, "High Score: %d", highScore);
-    VDP_drawText(buf, 13, 21);
-    
-    // Sound toggle
-    VDP_drawText("C: Sound", 16, 23);
-    VDP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
+    { 13, 21, hiScoreText },
+    { 16, 23, "C: Sound" },
     
     // Footer
-    VDP_drawText("(C) 2026 monteslu", 11, 27);
+    { 11, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+// Static text is in titleScreen, only what moves or toggles is drawn here
+static void drawTitle(void) {
+    TMAP_clear();
+    
+    // Demo bricks (palette x % 3, x starts at a multiple of 3) and ball
+    u8 pal = 0;
+    for (u8 x = 12; x < 28; x++) {
+        TMAP_setTile(TILE_ATTR_FULL(PAL1 + pal, 0, 0, 0, TILE_BRICK), x, 11);
+        pal = (pal == 2) ? 0 : pal + 1;
+    }
+    if (titleTimer) titleTimer--;
+    else {
+        titleTimer = 2;
+        titleBallX = (titleBallX == 9) ? 0 : titleBallX + 1;
+    }
+    TMAP_setTile(TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), 15 + titleBallX, 13);
+    
+    // Sound toggle
+    TMAP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
 }
 
 static void drawGameOver() {
     draw();
     
-    if (frameCount % 10 < 5) {
-        VDP_drawText("=== GAME OVER ===", 11, 10);
+    if (FDIV_MOD10(frameCount) < 5) {
+        TMAP_drawText("=== GAME OVER ===", 11, 10);
     }
     
-    char buf[24];
-    sprintf(buf, "Final Score: %d", score);
-    VDP_drawText(buf, 12, 13);
+    TMAP_drawText(finalText[0], 12, 13);
+    TMAP_drawText(finalText[1], 12, 15);
     
-    sprintf(buf, "Level Reached: %d", level);
-    VDP_drawText(buf, 12, 15);
-    
-    if (score > highScore) {
-        highScore = score;
-        VDP_drawText("*** NEW HIGH SCORE! ***", 8, 18);
+    if (newHighScore) {
+        TMAP_drawText("*** NEW HIGH SCORE! ***", 8, 18);
     }
     
-    VDP_drawText("Press START", 14, 22);
+    TMAP_drawText("Press START", 14, 22);
 }
 
+// Title frame for the cycle benchmark: 16 demo brick palettes and the
+// ball step
+static const BenchProfile benchProfile = { 18, 17, 0, 0, 0 };
+
 int main() {
     VDP_setScreenWidth320();
     PAL_setColor(0, RGB24_TO_VDPCOLOR(0x000000));
@@ -490,16 +554,45 @@ int main() {
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0x00FF00)); // Green paddle + bricks
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0x0088FF)); // Blue bricks + ball2
     
+    // Brick flash entries rest on the brick colour
+    for (u16 pal = PAL1; pal <= PAL3; pal++) {
+        PAL_setColor(pal * 16 + BRICK_FLASH_INDEX, PAL_getColor(pal * 16 + 3));
+    }
+    
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("BREAKOUT", &benchProfile);
+    
+    RNG_init(12345);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    TANIM_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    SPRL_init();
+    PART_init(32);
+    SCHED_init(0);
+    SCHED_addTask(PART_update, 4);
+    PART_setGravity(FIX16(0.125));
+    TMAP_init(BG_A, 0);
+    HUD_init(FALSE, 2);
+    HUD_setupCounter(HUD_SCORE, 7, 0, 5, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LEVEL, 19, 0, 3, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LIVES, 30, 0, 3, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_COMBO, 36, 0, 3, HUD_ALIGN_LEFT);
+    sprintf(hiScoreText, "High Score: %d", highScore);
     gameState = 0;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFF8888), 20);  // Pulsing title color
+    SCRN_load(BG_B, titleScreen);
     drawTitle();
     
-    u16 lastJoy = 0;
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy;
-        seed += frameCount;
+        SCHED_beginFrame();
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
         
         if (gameState == 0) {
             if (pressed & BUTTON_START) {
@@ -510,24 +603,30 @@ int main() {
                 soundEnabled = !soundEnabled;
                 playMenuBlip();
             }
-            drawTitle();
+            // A new state has drawn its own screen already
+            if (gameState == 0) drawTitle();
         } else if (gameState == 1) {
-            if (frameCount % 2 == 0) update();  // Smoother gameplay
-            updateShake();
-            updateSound();
+            while (ticks-- && gameState == 1) update();
+            SCHED_runOptional();
             draw();
         } else {
             drawGameOver();
-            updateSound();
             if (pressed & BUTTON_START) {
                 playMenuBlip();
                 gameState = 0;
-                VDP_clearPlane(BG_A, TRUE);
+                HUD_show(FALSE);
+                PFX_stopAll();
+                PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFF8888), 20);
+                sprintf(hiScoreText, "High Score: %d", highScore);
+                SCRN_load(BG_B, titleScreen);
                 drawTitle();
             }
         }
         frameCount++;
+        TMAP_flush();
+        SPRL_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     return 0;
 }
@@ -0,0 +1,30 @@
+/**
+ * Z80 audio - shared by all Genesis games
+ */
+
+#include "audio.h"
+
+void AUD_init(void) {
+    XGM2_loadDriver(TRUE);
+}
+
+void AUD_playMusic(const u8* song) {
+    XGM2_play(song);
+}
+
+void AUD_stopMusic(void) {
+    XGM2_stop();
+}
+
+void AUD_pauseMusic(void) {
+    XGM2_pause();
+}
+
+void AUD_resumeMusic(void) {
+    XGM2_resume();
+}
+
+bool AUD_playPCM(const u8* sample, u32 len, u8 priority) {
+    // The driver picks the channel and does the priority check itself
+    return XGM2_playPCMEx(sample, len, SOUND_PCM_CH_AUTO, priority, FALSE, FALSE);
+}
@@ -0,0 +1,39 @@
+/**
+ * Z80 audio - shared by all Genesis games
+ *
+ * Music and PCM samples run on SGDK's XGM2 driver in the Z80. Starting a
+ * track or a sample is one command written to Z80 RAM; the driver does
+ * every YM2612 write, and the status waits they need, on its own time.
+ * Tone and noise effects stay on the PSG through common/sfx.
+ *
+ * Samples are WAV resources converted for the driver, and take one of
+ * the three PCM channels; when all are busy the one playing the lowest
+ * priority sample is cut, if that is no higher than the new one.
+ *
+ *   WAV explode_pcm "explode.wav" XGM2         (resources.res)
+ *   AUD_PLAY_PCM(explode_pcm, SFX_PRIO_HIGH);
+ */
+
+#ifndef _COMMON_AUDIO_H_
+#define _COMMON_AUDIO_H_
+
+#include <genesis.h>
+
+// Samples are declared as sized arrays, so the length comes for free
+#define AUD_PLAY_PCM(res, priority)     AUD_playPCM(res, sizeof(res), priority)
+
+// Load the driver into the Z80 and wait until it runs
+void AUD_init(void);
+
+// Start an XGM2 track (looping as authored), or stop it
+void AUD_playMusic(const u8* song);
+void AUD_stopMusic(void);
+// Hold the track where it is, and carry on from there
+void AUD_pauseMusic(void);
+void AUD_resumeMusic(void);
+
+// Play a sample on a free PCM channel; 'priority' 0..15, as SFX_PRIO_*.
+// FALSE if every channel is busy with something more important.
+bool AUD_playPCM(const u8* sample, u32 len, u8 priority);
+
+#endif // _COMMON_AUDIO_H_
@@ -0,0 +1,107 @@
+/**
+ * Cycle benchmark - shared by all Genesis games
+ */
+
+#include "bench.h"
+#include "fastdiv.h"
+
+// 68000 cycles per scanline (3420 master clocks / 7)
+#define LINE_CYCLES 488
+
+enum { OP_EMPTY, OP_DIVU, OP_COUNTER, OP_MASK, OP_RECIP, OP_TABLE, NUM_OPS };
+
+static const char* const opNames[NUM_OPS] = {
+    "", "DIVU    ", "COUNTER ", "MASK    ", "RECIP   ", "TABLE   "
+};
+
+// Volatile so every run really loads, computes and stores
+static vu16 value = 12345;
+static vu16 divisor = 37;
+static vu16 slot = 5;
+static vu16 counter;
+static vu16 sink;
+
+static const u8 table[8] = { 1, 2, 3, 1, 2, 3, 1, 2 };
+
+bool BENCH_requested(void) {
+    // Pad state is only read in vblank
+    SYS_doVBlankProcess();
+    u16 abc = BUTTON_A | BUTTON_B | BUTTON_C;
+    return (JOY_readJoypad(JOY_1) & abc) == abc;
+}
+
+// Scanlines BENCH_RUNS of 'op' take
+static u16 timeOp(u16 op) {
+    // Start at the top of the display, the counter jumps around in vblank
+    SYS_doVBlankProcess();
+    while (GET_VDP_STATUS(VDP_VBLANK_FLAG));
+    u16 start = GET_VCOUNTER;
+
+    u16 n = BENCH_RUNS;
+    switch (op) {
+        case OP_EMPTY:
+            while (n--) sink = value;
+            break;
+        case OP_DIVU:
+            while (n--) sink = (u16)value % (u16)divisor;
+            break;
+        case OP_COUNTER:
+            while (n--) {
+                u16 t = counter;
+                if (t) t--;
+                else t = divisor;
+                counter = t;
+            }
+            break;
+        case OP_MASK:
+            while (n--) sink = value & 7;
+            break;
+        case OP_RECIP:
+            while (n--) sink = FDIV_RANGE(value, divisor);
+            break;
+        case OP_TABLE:
+            while (n--) sink = table[slot];
+            break;
+    }
+    return GET_VCOUNTER - start;
+}
+
+void BENCH_run(const char* game, const BenchProfile* profile) {
+    u16 cycles[NUM_OPS];
+    u16 empty = timeOp(OP_EMPTY);
+    for (u16 op = OP_DIVU; op < NUM_OPS; op++) {
+        s16 lines = timeOp(op) - empty;
+        cycles[op] = (lines > 0) ? ((u32)lines * LINE_CYCLES) / BENCH_RUNS : 0;
+    }
+
+    u32 before = (u32)profile->divs * cycles[OP_DIVU];
+    u32 after = (u32)profile->counters * cycles[OP_COUNTER]
+              + (u32)profile->masks * cycles[OP_MASK]
+              + (u32)profile->recips * cycles[OP_RECIP]
+              + (u32)profile->tables * cycles[OP_TABLE];
+    u32 saved = (before > after) ? before - after : 0;
+
+    char text[40];
+    VDP_clearPlane(BG_A, TRUE);
+    sprintf(text, "CYCLE BENCHMARK: %s", game);
+    VDP_drawText(text, 2, 2);
+
+    VDP_drawText("CYCLES PER OP", 2, 4);
+    for (u16 op = OP_DIVU; op < NUM_OPS; op++) {
+        sprintf(text, "%s%5d", opNames[op], cycles[op]);
+        VDP_drawText(text, 4, 4 + op);
+    }
+
+    VDP_drawText("CYCLES PER FRAME", 2, 11);
+    sprintf(text, "BEFORE  %5lu", before);
+    VDP_drawText(text, 4, 12);
+    sprintf(text, "AFTER   %5lu", after);
+    VDP_drawText(text, 4, 13);
+    sprintf(text, "SAVED   %5lu  (%lu LINES)", saved, saved / LINE_CYCLES);
+    VDP_drawText(text, 4, 14);
+
+    VDP_drawText("PRESS START", 2, 17);
+    while (!(JOY_readJoypad(JOY_1) & BUTTON_START)) SYS_doVBlankProcess();
+    while (JOY_readJoypad(JOY_1) & BUTTON_START) SYS_doVBlankProcess();
+    VDP_clearPlane(BG_A, TRUE);
+}
@@ -0,0 +1,39 @@
+/**
+ * Cycle benchmark - shared by all Genesis games
+ *
+ * Shows what taking division out of the main loops saves. BENCH_run
+ * times a DIVU modulo and each idiom that replaced it (down-counter,
+ * power-of-two mask, reciprocal multiply, table lookup) on the real
+ * CPU, then prices one frame of the game both ways from its profile.
+ *
+ * Each idiom runs BENCH_RUNS times inside one display period and is
+ * timed with the V-counter, less the cost of an empty loop. A scanline
+ * is about 488 68000 cycles, so results are good to a couple of cycles.
+ *
+ *   if (BENCH_requested()) BENCH_run("PONG", &benchProfile);
+ */
+
+#ifndef _COMMON_BENCH_H_
+#define _COMMON_BENCH_H_
+
+#include <genesis.h>
+
+#define BENCH_RUNS  256
+
+// Work per frame before and after, in number of operations
+typedef struct {
+    u8 divs;        // divisions and modulos the old frame did
+    u8 counters;    // down-counter ticks that replaced them
+    u8 masks;       // power-of-two masks
+    u8 recips;      // reciprocal multiplies (FDIV_*)
+    u8 tables;      // table lookups
+} BenchProfile;
+
+// TRUE if A, B and C are all held on pad 1
+bool BENCH_requested(void);
+
+// Time the idioms, print the per-frame cycles for 'profile' on BG_A and
+// wait for START. Leaves BG_A cleared.
+void BENCH_run(const char* game, const BenchProfile* profile);
+
+#endif // _COMMON_BENCH_H_
@@ -0,0 +1,53 @@
+/**
+ * Frame coroutines - shared by all Genesis games
+ */
+
+#include "coro.h"
+
+typedef struct {
+    CoroFunc* func;     // NULL while the slot is free
+    Coro coro;
+} Task;
+
+static Task tasks[CORO_MAX_TASKS];
+
+static Task* find(CoroFunc* func) {
+    for (u16 i = 0; i < CORO_MAX_TASKS; i++) {
+        if (tasks[i].func == func) return &tasks[i];
+    }
+    return NULL;
+}
+
+void CORO_init(void) {
+    for (u16 i = 0; i < CORO_MAX_TASKS; i++) tasks[i].func = NULL;
+}
+
+bool CORO_start(CoroFunc* func) {
+    Task* t = find(func);
+    if (!t) t = find(NULL);
+    if (!t) return FALSE;
+
+    t->func = func;
+    t->coro.line = 0;
+    t->coro.timer = 0;
+    return TRUE;
+}
+
+void CORO_stop(CoroFunc* func) {
+    Task* t = find(func);
+    if (t) t->func = NULL;
+}
+
+bool CORO_isRunning(CoroFunc* func) {
+    return find(func) != NULL;
+}
+
+void CORO_update(u16 ticks) {
+    for (u16 i = 0; i < CORO_MAX_TASKS; i++) {
+        Task* t = &tasks[i];
+        if (!t->func) continue;
+
+        t->coro.timer = t->coro.timer > ticks ? t->coro.timer - ticks : 0;
+        if (!t->func(&t->coro)) t->func = NULL;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * Frame coroutines - shared by all Genesis games
+ *
+ * Stackless, protothread-style tasks for sequences that span many frames
+ * (round transitions, pause screens, jingles). A task is a function that
+ * runs from where it last yielded each time the main loop calls
+ * CORO_update(), so a sequence reads top to bottom without ever blocking
+ * drawing or input.
+ *
+ *   static bool blinkTask(Coro* c) {
+ *       CORO_BEGIN(c);
+ *       showText();
+ *       CORO_WAIT(c, 30);
+ *       hideText();
+ *       CORO_END(c);
+ *   }
+ *   CORO_start(blinkTask);
+ *
+ * The resume point is a switch on a line number, so local variables do
+ * not survive a wait (keep state in statics or the game's structs) and
+ * the CORO_ macros cannot be used inside a switch of the task's own.
+ */
+
+#ifndef _COMMON_CORO_H_
+#define _COMMON_CORO_H_
+
+#include <genesis.h>
+
+#define CORO_MAX_TASKS  4
+
+typedef struct {
+    u16 line;       // where to resume, 0 at the top
+    u16 timer;      // ticks left for CORO_WAIT
+} Coro;
+
+// Returns TRUE while the task has more to do
+typedef bool CoroFunc(Coro* c);
+
+#define CORO_BEGIN(c)       switch ((c)->line) { case 0:
+#define CORO_END(c)         } (c)->line = 0; return FALSE
+
+// Resume here next frame
+#define CORO_YIELD(c) \
+    do { (c)->line = __LINE__; return TRUE; case __LINE__:; } while (0)
+// Resume here on the first frame 'cond' holds, maybe this one
+#define CORO_WAIT_UNTIL(c, cond) \
+    do { (c)->line = __LINE__; case __LINE__: if (!(cond)) return TRUE; } while (0)
+// Resume here once 'ticks' simulation ticks have passed
+#define CORO_WAIT(c, ticks) \
+    do { (c)->timer = (ticks); CORO_WAIT_UNTIL(c, !(c)->timer); } while (0)
+
+// Forget every task
+void CORO_init(void);
+
+// Run 'func' from the top at the next update (restarting it if it was
+// already running); FALSE if every slot is busy
+bool CORO_start(CoroFunc* func);
+void CORO_stop(CoroFunc* func);
+bool CORO_isRunning(CoroFunc* func);
+
+// Call once per frame with the ticks from LOOP_beginFrame(); advances
+// every task's timer, then runs each task up to its next wait
+void CORO_update(u16 ticks);
+
+#endif // _COMMON_CORO_H_
@@ -0,0 +1,27 @@
+/**
+ * Division-free helpers - shared by all Genesis games
+ *
+ * DIVU costs the 68000 around 140 cycles, so per-frame code should not
+ * divide. Pacing belongs in down-counters and power-of-two cycles in
+ * masks; what is left - picking a random value in a range, or dividing
+ * by a small constant - is a MULU by a reciprocal and a shift instead.
+ * All of these are exact for any u16 input.
+ */
+
+#ifndef _COMMON_FASTDIV_H_
+#define _COMMON_FASTDIV_H_
+
+#include <genesis.h>
+
+// Scale a 15-bit random value 'r' into [0, n), n at most 65535
+#define FDIV_RANGE(r, n)    ((u16)(((u32)(u16)(r) * (u16)(n)) >> 15))
+
+// x / 3 and x % 3
+#define FDIV_DIV3(x)        ((u16)(((u32)(u16)(x) * 0xAAABu) >> 17))
+#define FDIV_MOD3(x)        ((u16)(x) - FDIV_DIV3(x) * 3)
+
+// x / 10 and x % 10
+#define FDIV_DIV10(x)       ((u16)(((u32)(u16)(x) * 0xCCCDu) >> 19))
+#define FDIV_MOD10(x)       ((u16)(x) - FDIV_DIV10(x) * 10)
+
+#endif // _COMMON_FASTDIV_H_
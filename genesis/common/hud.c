@@ -0,0 +1,130 @@
+/**
+ * HUD - shared by all Genesis games
+ */
+
+#include "hud.h"
+
+typedef struct {
+    u32 value;
+    s16 x, y;
+    u8 digits;
+    u16 flags;
+    bool visible;
+} HudCounter;
+
+static const u32 pow10[HUD_MAX_DIGITS] = {
+    1000000000, 100000000, 10000000, 1000000, 100000,
+    10000, 1000, 100, 10, 1
+};
+
+// What the window plane holds in the HUD rows
+static u16 cells[HUD_MAX_ROWS][HUD_W];
+static u16 firstRow;
+static u16 numRows;
+static bool bottomBand;
+static u16 textBase;
+static HudCounter counters[HUD_MAX_COUNTERS];
+
+static void putCell(s16 x, s16 y, u16 attr) {
+    u16 row = y - firstRow;
+    if ((u16)x >= HUD_W || row >= numRows) return;
+    if (cells[row][x] == attr) return;
+
+    cells[row][x] = attr;
+    VDP_setTileMapXY(WINDOW, attr, x, y);
+}
+
+void HUD_init(bool bottom, u16 rows) {
+    if (rows > HUD_MAX_ROWS) rows = HUD_MAX_ROWS;
+    numRows = rows;
+    bottomBand = bottom;
+    firstRow = bottom ? (VDP_getScreenHeight() / 8) - rows : 0;
+    textBase = TILE_ATTR(VDP_getTextPalette(), VDP_getTextPriority(), FALSE, FALSE)
+             + TILE_FONT_INDEX;
+
+    memset(counters, 0, sizeof(counters));
+    HUD_show(FALSE);
+    HUD_clear();
+}
+
+void HUD_show(bool show) {
+    // Window covers whole rows only, never columns
+    VDP_setWindowHPos(FALSE, 0);
+    if (!show) {
+        VDP_setWindowVPos(FALSE, 0);
+    } else if (bottomBand) {
+        VDP_setWindowVPos(TRUE, firstRow);
+    } else {
+        VDP_setWindowVPos(FALSE, numRows);
+    }
+}
+
+void HUD_clear(void) {
+    VDP_clearTileMapRect(WINDOW, 0, firstRow, HUD_W, numRows);
+    memset(cells, 0, sizeof(cells));
+    for (u8 i = 0; i < HUD_MAX_COUNTERS; i++) counters[i].visible = FALSE;
+}
+
+void HUD_drawText(const char* str, s16 x, s16 y) {
+    while (*str) {
+        u8 c = *str++;
+        putCell(x++, y, (c < 32) ? 0 : textBase + (c - 32));
+    }
+}
+
+void HUD_clearText(s16 x, s16 y, u16 w) {
+    while (w--) putCell(x++, y, 0);
+}
+
+void HUD_setupCounter(u8 id, s16 x, s16 y, u8 digits, u16 flags) {
+    HudCounter* c = &counters[id];
+    if (digits > HUD_MAX_DIGITS) digits = HUD_MAX_DIGITS;
+    c->x = x;
+    c->y = y;
+    c->digits = digits;
+    c->flags = flags;
+    c->visible = FALSE;
+}
+
+void HUD_setCounter(u8 id, u32 value) {
+    HudCounter* c = &counters[id];
+    if (c->visible && c->value == value) return;
+    c->value = value;
+    c->visible = TRUE;
+
+    u8 n = c->digits;
+    const u32* p = &pow10[HUD_MAX_DIGITS - n];
+    if (n < HUD_MAX_DIGITS && value >= p[-1]) value = p[-1] - 1;
+
+    // Most significant digit first, leading zeros dropped unless padded
+    u16 tiles[HUD_MAX_DIGITS];
+    u8 len = 0;
+    bool leading = !(c->flags & HUD_ZERO_PAD);
+    for (u8 i = 0; i < n; i++) {
+        u8 d = 0;
+        while (value >= p[i]) {
+            value -= p[i];
+            d++;
+        }
+        if (d == 0 && leading && i < n - 1) continue;
+        leading = FALSE;
+        tiles[len++] = textBase + ('0' - 32) + d;
+    }
+
+    s16 x = c->x;
+    bool left = c->flags & HUD_ALIGN_LEFT;
+    if (!left) {
+        for (u8 i = len; i < n; i++) putCell(x++, c->y, 0);
+    }
+    for (u8 i = 0; i < len; i++) putCell(x++, c->y, tiles[i]);
+    if (left) {
+        for (u8 i = len; i < n; i++) putCell(x++, c->y, 0);
+    }
+}
+
+void HUD_hideCounter(u8 id) {
+    HudCounter* c = &counters[id];
+    if (!c->visible) return;
+    c->visible = FALSE;
+    HUD_clearText(c->x, c->y, c->digits);
+}
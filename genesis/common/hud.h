@@ -0,0 +1,42 @@
+/**
+ * HUD - shared by all Genesis games
+ *
+ * Score and status lines on the WINDOW plane. The window never scrolls,
+ * so screen shake leaves the HUD alone. A RAM copy of the HUD cells means
+ * only tiles that actually change are written to VRAM, and counters are
+ * turned into digits by repeated subtraction (no division, no sprintf),
+ * and only when their value changes.
+ */
+
+#ifndef _COMMON_HUD_H_
+#define _COMMON_HUD_H_
+
+#include <genesis.h>
+
+#define HUD_W               40
+#define HUD_MAX_ROWS        4
+#define HUD_MAX_COUNTERS    8
+#define HUD_MAX_DIGITS      10      // enough for any u32
+
+// Counter flags
+#define HUD_ZERO_PAD        0x0001  // leading zeros instead of blanks
+#define HUD_ALIGN_LEFT      0x0002  // digits start at x, blanks trail
+
+// Reserve 'rows' screen rows at the top or bottom; starts hidden
+void HUD_init(bool bottom, u16 rows);
+void HUD_show(bool show);
+// Blank every HUD cell and hide all counters
+void HUD_clear(void);
+
+// Coordinates are screen cells and must fall inside the HUD rows.
+// Cells already showing the right tile are skipped, so redrawing the
+// same text every frame costs no VRAM writes.
+void HUD_drawText(const char* str, s16 x, s16 y);
+void HUD_clearText(s16 x, s16 y, u16 w);
+
+// A counter occupies 'digits' cells; larger values show as all nines
+void HUD_setupCounter(u8 id, s16 x, s16 y, u8 digits, u16 flags);
+void HUD_setCounter(u8 id, u32 value);
+void HUD_hideCounter(u8 id);
+
+#endif // _COMMON_HUD_H_
@@ -0,0 +1,93 @@
+/**
+ * Joypad input - shared by all Genesis games
+ */
+
+#include "input.h"
+#include "vblank.h"
+
+#define QUEUE_MASK  (INPUT_QUEUE_SIZE - 1)
+
+typedef struct {
+    u16 button;
+    u16 frame;      // vtimer when it was sampled
+} QueuedPress;
+
+typedef struct {
+    u16 held;
+    u16 pressed;
+    u16 released;
+    QueuedPress queue[INPUT_QUEUE_SIZE];
+    u8 head, count;
+} PadState;
+
+static PadState pads[INPUT_PADS];
+static u16 latency;
+static u16 maxLatency;
+
+// D-pad bits in the order simultaneous presses are queued
+static const u16 dirButtons[4] = { BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT };
+
+static void update(void) {
+    for (u16 i = 0; i < INPUT_PADS; i++) {
+        PadState* p = &pads[i];
+        u16 joy = JOY_readJoypad(i == 0 ? JOY_1 : JOY_2);
+        p->pressed = joy & ~p->held;
+        p->released = p->held & ~joy;
+        p->held = joy;
+
+        if (!(p->pressed & BUTTON_DIR)) continue;
+        for (u16 d = 0; d < 4; d++) {
+            if (!(p->pressed & dirButtons[d])) continue;
+            // A full queue keeps its oldest presses
+            if (p->count == INPUT_QUEUE_SIZE) break;
+            QueuedPress* q = &p->queue[(p->head + p->count) & QUEUE_MASK];
+            q->button = dirButtons[d];
+            q->frame = vtimer;
+            p->count++;
+        }
+    }
+}
+
+void INPUT_init(void) {
+    memset(pads, 0, sizeof(pads));
+    latency = 0;
+    maxLatency = 0;
+    VBL_addTask(update);
+}
+
+void INPUT_clear(void) {
+    for (u16 i = 0; i < INPUT_PADS; i++) pads[i].count = 0;
+}
+
+u16 INPUT_held(u16 pad) {
+    return pads[pad].held;
+}
+
+u16 INPUT_pressed(u16 pad) {
+    return pads[pad].pressed;
+}
+
+u16 INPUT_released(u16 pad) {
+    return pads[pad].released;
+}
+
+u16 INPUT_popDir(u16 pad) {
+    PadState* p = &pads[pad];
+    if (!p->count) return 0;
+
+    QueuedPress* q = &p->queue[p->head];
+    p->head = (p->head + 1) & QUEUE_MASK;
+    p->count--;
+
+    latency = (u16)vtimer - q->frame;
+    if (latency > maxLatency) maxLatency = latency;
+    return q->button;
+}
+
+u16 INPUT_getLatency(void) {
+    return latency;
+}
+
+u16 INPUT_getMaxLatency(void) {
+    return maxLatency;
+}
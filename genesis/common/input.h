@@ -0,0 +1,41 @@
+/**
+ * Joypad input - shared by all Genesis games
+ *
+ * Both pads are sampled once per frame by a vblank task, so everything
+ * the game reads in a frame agrees: held buttons, and the buttons that
+ * went down or up since the previous sample.
+ *
+ * Every d-pad press is also queued per pad, in order. A game that acts
+ * less often than once a frame (snake moves every few frames) or wants
+ * every tap (4Tris shifts) pops the queue instead of reading edges, so
+ * presses between its ticks are not lost. Popping a press records how
+ * many frames it waited, for tuning input latency.
+ */
+
+#ifndef _COMMON_INPUT_H_
+#define _COMMON_INPUT_H_
+
+#include <genesis.h>
+
+#define INPUT_PADS          2
+#define INPUT_QUEUE_SIZE    8   // queued d-pad presses per pad, power of two
+
+// Clear all state and hook the vblank task
+void INPUT_init(void);
+// Drop every queued press, e.g. when a game starts
+void INPUT_clear(void);
+
+// Buttons held, newly pressed and newly released at the last sample;
+// 'pad' is JOY_1 or JOY_2
+u16 INPUT_held(u16 pad);
+u16 INPUT_pressed(u16 pad);
+u16 INPUT_released(u16 pad);
+
+// Oldest queued d-pad press (one BUTTON_UP/DOWN/LEFT/RIGHT), 0 if none
+u16 INPUT_popDir(u16 pad);
+
+// Frames the last popped press waited in the queue, and the most seen
+u16 INPUT_getLatency(void);
+u16 INPUT_getMaxLatency(void);
+
+#endif // _COMMON_INPUT_H_
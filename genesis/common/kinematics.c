@@ -0,0 +1,59 @@
+/**
+ * Kinematics - shared by all Genesis games
+ */
+
+#include "kinematics.h"
+
+void KIN_set(KinBody* body, s16 x, s16 y, fix16 vx, fix16 vy) {
+    body->x = intToFix16(x);
+    body->y = intToFix16(y);
+    body->vx = vx;
+    body->vy = vy;
+}
+
+void KIN_step(KinBody* body) {
+    body->x += body->vx;
+    body->y += body->vy;
+}
+
+void KIN_stepAll(KinBody* bodies, u16 num) {
+    while (num--) {
+        bodies->x += bodies->vx;
+        bodies->y += bodies->vy;
+        bodies++;
+    }
+}
+
+fix16 KIN_approach(fix16 value, fix16 target, fix16 rate) {
+    if (value < target) return (target - value > rate) ? value + rate : target;
+    if (value > target) return (value - target > rate) ? value - rate : target;
+    return value;
+}
+
+bool KIN_clampX(KinBody* body, s16 min, s16 max) {
+    if (body->x < intToFix16(min)) {
+        body->x = intToFix16(min);
+        if (body->vx < 0) body->vx = 0;
+        return TRUE;
+    }
+    if (body->x > intToFix16(max)) {
+        body->x = intToFix16(max);
+        if (body->vx > 0) body->vx = 0;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+bool KIN_clampY(KinBody* body, s16 min, s16 max) {
+    if (body->y < intToFix16(min)) {
+        body->y = intToFix16(min);
+        if (body->vy < 0) body->vy = 0;
+        return TRUE;
+    }
+    if (body->y > intToFix16(max)) {
+        body->y = intToFix16(max);
+        if (body->vy > 0) body->vy = 0;
+        return TRUE;
+    }
+    return FALSE;
+}
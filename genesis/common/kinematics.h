@@ -0,0 +1,44 @@
+/**
+ * Kinematics - shared by all Genesis games
+ *
+ * Positions and velocities in fix16 pixels (1/64 pixel steps, range
+ * +-511), so objects move a fraction of a pixel or several pixels on
+ * every frame instead of whole tiles every Nth frame. Speeds are plain
+ * fix16 constants and can sit in ROM tables: FIX16(2.5) is 2.5 pixels
+ * per frame.
+ *
+ * Collision stays in the games; a body only knows where it is and how
+ * fast it goes.
+ */
+
+#ifndef _COMMON_KINEMATICS_H_
+#define _COMMON_KINEMATICS_H_
+
+#include <genesis.h>
+
+typedef struct {
+    fix16 x, y;
+    fix16 vx, vy;
+} KinBody;
+
+// Whole-pixel position (top-left), and the 8x8 cell it mostly covers
+#define KIN_X(b)        fix16ToInt((b)->x)
+#define KIN_Y(b)        fix16ToInt((b)->y)
+#define KIN_CELL_X(b)   ((KIN_X(b) + 4) >> 3)
+#define KIN_CELL_Y(b)   ((KIN_Y(b) + 4) >> 3)
+
+// Place at pixel (x, y) with a velocity in pixels per frame
+void KIN_set(KinBody* body, s16 x, s16 y, fix16 vx, fix16 vy);
+
+// Advance one frame
+void KIN_step(KinBody* body);
+void KIN_stepAll(KinBody* bodies, u16 num);
+
+// Move 'value' towards 'target' by at most 'rate' (acceleration, friction)
+fix16 KIN_approach(fix16 value, fix16 target, fix16 rate);
+// Keep the position inside [min, max] pixels on each axis, stopping the
+// velocity that pushed it out. Returns TRUE if it was clamped.
+bool KIN_clampX(KinBody* body, s16 min, s16 max);
+bool KIN_clampY(KinBody* body, s16 min, s16 max);
+
+#endif // _COMMON_KINEMATICS_H_
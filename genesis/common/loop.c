@@ -0,0 +1,53 @@
+/**
+ * Fixed-timestep main loop - shared by all Genesis games
+ */
+
+#include "loop.h"
+
+// Each vblank adds LOOP_TICK_HZ to the accumulator and each tick takes
+// the refresh rate back out, so no fractions are needed
+static u16 refreshHz;
+static u16 accumulator;
+static u32 lastVTimer;
+static u32 dropped;
+static bool pal;
+
+void LOOP_init(void) {
+    pal = SYS_isPAL();
+    refreshHz = pal ? 50 : 60;
+    dropped = 0;
+    LOOP_reset();
+}
+
+void LOOP_reset(void) {
+    accumulator = 0;
+    lastVTimer = vtimer;
+}
+
+u16 LOOP_beginFrame(void) {
+    u32 elapsed = vtimer - lastVTimer;
+    lastVTimer = vtimer;
+
+    // Anything past the cap is dropped anyway, keep the sum in range
+    if (elapsed > LOOP_MAX_TICKS + 1) elapsed = LOOP_MAX_TICKS + 1;
+    accumulator += (u16)elapsed * LOOP_TICK_HZ;
+
+    u16 ticks = 0;
+    while (accumulator >= refreshHz) {
+        accumulator -= refreshHz;
+        ticks++;
+    }
+    if (ticks > LOOP_MAX_TICKS) {
+        dropped += ticks - LOOP_MAX_TICKS;
+        ticks = LOOP_MAX_TICKS;
+    }
+    return ticks;
+}
+
+bool LOOP_isPAL(void) {
+    return pal;
+}
+
+u32 LOOP_getDropped(void) {
+    return dropped;
+}
@@ -0,0 +1,41 @@
+/**
+ * Fixed-timestep main loop - shared by all Genesis games
+ *
+ * Simulation runs at LOOP_TICK_HZ whatever the video standard, and the
+ * game draws once per vblank. Each frame LOOP_beginFrame() adds the
+ * vblanks that passed since the last frame to an accumulator and says
+ * how many simulation ticks are due: always 1 on NTSC, 1 or 2 on PAL
+ * (6 ticks every 5 frames), more after a missed vblank so the game
+ * catches up instead of slowing down.
+ *
+ * At most LOOP_MAX_TICKS run in one frame; time past that is dropped so
+ * one slow frame cannot snowball into more slow frames.
+ *
+ *   for (u16 n = LOOP_beginFrame(); n--; ) update();
+ *
+ * Anything driven by a button press (not a held button) belongs outside
+ * the tick loop, so a 2-tick frame does not act on it twice.
+ */
+
+#ifndef _COMMON_LOOP_H_
+#define _COMMON_LOOP_H_
+
+#include <genesis.h>
+
+#define LOOP_TICK_HZ    60
+#define LOOP_MAX_TICKS  3
+
+// Detect NTSC / PAL and start the accumulator
+void LOOP_init(void);
+// Forget time that passed while the loop was not running (pause, loading)
+void LOOP_reset(void);
+
+// Call once per frame, right after SYS_doVBlankProcess(). Returns the
+// simulation ticks to run this frame.
+u16 LOOP_beginFrame(void);
+
+bool LOOP_isPAL(void);
+// Ticks dropped by the catch-up cap
+u32 LOOP_getDropped(void);
+
+#endif // _COMMON_LOOP_H_
@@ -0,0 +1,258 @@
+/**
+ * Palette effects - shared by all Genesis games
+ */
+
+#include "palfx.h"
+#include "vblank.h"
+
+#define PFX_COLORS      64
+
+// Also the order effects are applied in
+#define PFX_NONE        0
+#define PFX_CYCLE       1
+#define PFX_FADE        2
+#define PFX_PULSE       3
+#define PFX_FLASH       4
+#define PFX_TYPES       5
+
+// Blend levels are 8.8 fixed point, 16.0 meaning fully 'color'
+#define PFX_LEVEL_MAX   (16 << 8)
+
+typedef struct {
+    u8 type;
+    u8 first;
+    u8 count;
+    u16 color;
+    u16 timer;      // frames left (flash), frames per step (cycle)
+    u16 rate;       // blink length (flash), step length (cycle)
+    u16 phase;      // blink countdown (flash), rotation (cycle)
+    s16 level;      // current blend (fade, pulse)
+    s16 target;     // blend to stop at (fade)
+    s16 step;       // blend change per frame (fade, pulse)
+} PalEffect;
+
+static u16 base[PFX_COLORS];
+static u16 cram[PFX_COLORS];    // what CRAM holds
+static u16 work[PFX_COLORS];
+static PalEffect effects[PFX_MAX_EFFECTS];
+static bool dirty;
+static s8 shadowPending = -1;   // mode to set at the next vblank
+
+// Per-channel blend of two VDP colours, amount 0-16
+static u16 blend(u16 from, u16 to, u16 amount) {
+    u16 result = 0;
+    for (u16 shift = 1; shift < 12; shift += 4) {
+        s16 a = (from >> shift) & 7;
+        s16 b = (to >> shift) & 7;
+        result |= (u16)(a + (((b - a) * (s16)amount) >> 4)) << shift;
+    }
+    return result;
+}
+
+static void applyEffect(PalEffect* e) {
+    u16* c = &work[e->first];
+
+    switch (e->type) {
+        case PFX_CYCLE: {
+            u16 tmp[PFX_COLORS];
+            u16 j = e->phase;
+            for (u16 i = 0; i < e->count; i++) {
+                tmp[i] = c[j];
+                if (++j >= e->count) j = 0;
+            }
+            memcpy(c, tmp, e->count * 2);
+            break;
+        }
+        case PFX_FADE:
+        case PFX_PULSE:
+            for (u16 i = 0; i < e->count; i++) {
+                c[i] = blend(c[i], e->color, e->level >> 8);
+            }
+            break;
+        case PFX_FLASH:
+            if (e->rate == 0 || e->phase <= e->rate) {
+                for (u16 i = 0; i < e->count; i++) c[i] = e->color;
+            }
+            break;
+    }
+}
+
+// Advance one frame, returns FALSE once the effect has finished
+static bool stepEffect(PalEffect* e) {
+    switch (e->type) {
+        case PFX_CYCLE:
+            if (--e->timer == 0) {
+                e->timer = e->rate;
+                if (++e->phase >= e->count) e->phase = 0;
+            }
+            return TRUE;
+        case PFX_FADE:
+            e->level += e->step;
+            if ((e->step >= 0 && e->level >= e->target) ||
+                (e->step < 0 && e->level <= e->target)) {
+                e->level = e->target;
+                e->step = 0;
+                // Faded all the way back: nothing left to apply
+                return e->level != 0;
+            }
+            return TRUE;
+        case PFX_PULSE:
+            e->level += e->step;
+            if (e->level >= PFX_LEVEL_MAX) {
+                e->level = PFX_LEVEL_MAX;
+                e->step = -e->step;
+            } else if (e->level <= 0) {
+                e->level = 0;
+                e->step = -e->step;
+            }
+            return TRUE;
+        case PFX_FLASH:
+            // 'phase' counts 1..rate showing 'color', rate+1..2*rate off
+            if (e->rate && ++e->phase > e->rate * 2) e->phase = 1;
+            return --e->timer != 0;
+    }
+    return FALSE;
+}
+
+static void update(void) {
+    if (shadowPending >= 0) {
+        VDP_setHilightShadow(shadowPending);
+        shadowPending = -1;
+    }
+
+    bool active = FALSE;
+    for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+        if (effects[i].type != PFX_NONE) active = TRUE;
+    }
+    if (!active && !dirty) return;
+    dirty = FALSE;
+
+    memcpy(work, base, sizeof(work));
+    for (u16 type = PFX_CYCLE; type < PFX_TYPES; type++) {
+        for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+            if (effects[i].type == type) applyEffect(&effects[i]);
+        }
+    }
+
+    for (u16 i = 0; i < PFX_COLORS; i++) {
+        if (work[i] != cram[i]) {
+            cram[i] = work[i];
+            PAL_setColor(i, work[i]);
+        }
+    }
+
+    for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+        PalEffect* e = &effects[i];
+        if (e->type != PFX_NONE && !stepEffect(e)) {
+            e->type = PFX_NONE;
+            // Base colours come back on the next frame
+            dirty = TRUE;
+        }
+    }
+}
+
+// Same kind of effect on the same entry replaces the old one
+static PalEffect* allocEffect(u8 type, u16 first, u16 count) {
+    PalEffect* slot = NULL;
+    for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+        PalEffect* e = &effects[i];
+        if (e->type == type && e->first == first) {
+            slot = e;
+            break;
+        }
+        if (e->type == PFX_NONE && !slot) slot = e;
+    }
+    if (!slot) {
+        SYS_die("PFX: too many effects");
+        return NULL;
+    }
+
+    if (first >= PFX_COLORS) first = PFX_COLORS - 1;
+    if (first + count > PFX_COLORS) count = PFX_COLORS - first;
+    slot->type = type;
+    slot->first = first;
+    slot->count = count;
+    dirty = TRUE;
+    return slot;
+}
+
+void PFX_init(void) {
+    for (u16 i = 0; i < PFX_COLORS; i++) base[i] = PAL_getColor(i);
+    memcpy(cram, base, sizeof(cram));
+    memset(effects, 0, sizeof(effects));
+    dirty = FALSE;
+    VBL_addTask(update);
+}
+
+void PFX_setColor(u16 index, u16 color) {
+    if (index >= PFX_COLORS) return;
+    base[index] = color;
+    dirty = TRUE;
+}
+
+u16 PFX_getColor(u16 index) {
+    return (index < PFX_COLORS) ? base[index] : 0;
+}
+
+void PFX_flash(u16 index, u16 color, u16 frames, u16 blink) {
+    if (!frames) return;
+    PalEffect* e = allocEffect(PFX_FLASH, index, 1);
+    if (!e) return;
+    e->color = color;
+    e->timer = frames;
+    e->rate = blink;
+    e->phase = 1;
+}
+
+void PFX_pulse(u16 index, u16 color, u16 period) {
+    PalEffect* e = allocEffect(PFX_PULSE, index, 1);
+    if (!e) return;
+    e->color = color;
+    e->level = 0;
+    // Up and back down again within one period
+    e->step = (2 * PFX_LEVEL_MAX) / (period ? period : 1);
+}
+
+void PFX_cycle(u16 first, u16 count, u16 frames) {
+    PalEffect* e = allocEffect(PFX_CYCLE, first, count);
+    if (!e) return;
+    e->rate = frames ? frames : 1;
+    e->timer = e->rate;
+    e->phase = 0;
+}
+
+void PFX_fade(u16 first, u16 count, u16 color, u16 amount, u16 frames) {
+    // Carry on from the current blend if this range is already fading
+    s16 level = 0;
+    for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+        if (effects[i].type == PFX_FADE && effects[i].first == first) level = effects[i].level;
+    }
+    if (amount > 16) amount = 16;
+
+    PalEffect* e = allocEffect(PFX_FADE, first, count);
+    if (!e) return;
+    e->color = color;
+    e->level = level;
+    e->target = amount << 8;
+    e->step = (e->target - level) / (s16)(frames ? frames : 1);
+    if (e->step == 0) e->level = e->target;
+}
+
+void PFX_stop(u16 index) {
+    for (u16 i = 0; i < PFX_MAX_EFFECTS; i++) {
+        PalEffect* e = &effects[i];
+        if (e->type != PFX_NONE && index >= e->first && index < e->first + e->count) {
+            e->type = PFX_NONE;
+            dirty = TRUE;
+        }
+    }
+}
+
+void PFX_stopAll(void) {
+    memset(effects, 0, sizeof(effects));
+    dirty = TRUE;
+}
+
+void PFX_setShadowHighlight(bool enable) {
+    shadowPending = enable ? 1 : 0;
+}
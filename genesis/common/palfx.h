@@ -0,0 +1,48 @@
+/**
+ * Palette effects - shared by all Genesis games
+ *
+ * Flashes, pulses, colour cycles and fades done by rewriting CRAM
+ * entries instead of redrawing tiles with another palette. Effects are
+ * stepped once per frame from a vblank task, which then writes only the
+ * CRAM entries whose colour actually changed.
+ *
+ * Colours are 9-bit VDP colours (RGB24_TO_VDPCOLOR) and entries are CRAM
+ * indices 0-63 (palette * 16 + colour). Effects are layered on top of
+ * each entry's base colour in this order: cycle, fade, pulse, flash.
+ */
+
+#ifndef _COMMON_PALFX_H_
+#define _COMMON_PALFX_H_
+
+#include <genesis.h>
+
+#define PFX_MAX_EFFECTS     8
+
+// Take the current CRAM contents as base colours; call after the game
+// has set up its palettes
+void PFX_init(void);
+
+// Change a base colour (use instead of PAL_setColor once PFX is running)
+void PFX_setColor(u16 index, u16 color);
+u16 PFX_getColor(u16 index);
+
+// Show 'color' for 'frames' frames; with blink > 0 alternate with the
+// base colour every 'blink' frames
+void PFX_flash(u16 index, u16 color, u16 frames, u16 blink);
+// Swing smoothly between the base colour and 'color' and back, forever
+void PFX_pulse(u16 index, u16 color, u16 period);
+// Rotate 'count' entries one step every 'frames' frames, forever
+void PFX_cycle(u16 first, u16 count, u16 frames);
+// Blend 'count' entries toward 'color' by amount/16 over 'frames' frames
+// and hold there; fading to amount 0 goes back to the base colours
+void PFX_fade(u16 first, u16 count, u16 color, u16 amount, u16 frames);
+
+// Stop every effect touching entry 'index'
+void PFX_stop(u16 index);
+void PFX_stopAll(void);
+
+// VDP shadow/highlight: low priority planes are drawn darkened.
+// Takes effect at the next vblank.
+void PFX_setShadowHighlight(bool enable);
+
+#endif // _COMMON_PALFX_H_
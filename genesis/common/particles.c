@@ -0,0 +1,112 @@
+/**
+ * Particles - shared by all Genesis games
+ */
+
+#include "particles.h"
+#include "rng.h"
+#include "screen.h"
+#include "sprites.h"
+#include "trig.h"
+#include "tilemap.h"
+
+// The pool, packed: entries 0 .. count - 1 are alive
+static fix16 posX[PART_MAX], posY[PART_MAX];
+static fix16 velX[PART_MAX], velY[PART_MAX];
+static u16 attrs[PART_MAX];
+static u8 lives[PART_MAX];
+static u8 flagsOf[PART_MAX];
+static u16 count;
+
+static u16 spawnBudget;
+static fix16 gravity;
+
+static u16 spriteMax;
+
+void PART_init(u16 maxSprites) {
+    spriteMax = maxSprites;
+    gravity = 0;
+    PART_clear();
+}
+
+void PART_clear(void) {
+    count = 0;
+    spawnBudget = PART_SPAWN_BUDGET;
+}
+
+void PART_setGravity(fix16 g) {
+    gravity = g;
+}
+
+bool PART_spawn(s16 x, s16 y, fix16 vx, fix16 vy, u16 attr, u8 life, u8 flags) {
+    if (!spawnBudget || count >= PART_MAX || !life) return FALSE;
+    spawnBudget--;
+
+    u16 i = count++;
+    posX[i] = intToFix16(x);
+    posY[i] = intToFix16(y);
+    velX[i] = vx;
+    velY[i] = vy;
+    attrs[i] = attr;
+    lives[i] = life;
+    flagsOf[i] = flags;
+    return TRUE;
+}
+
+void PART_burst(s16 x, s16 y, u16 num, fix16 speed, u16 attr, u8 life, u8 flags) {
+    while (num--) {
+        u16 r = RNG_next(RNG_FX);
+        // Any angle, half to full speed in 1/32 steps
+        fix16 s = (fix16)(((s32)speed * (32 + ((r >> 8) & 31))) >> 6);
+        fix16 vx, vy;
+        TRIG_polar(r & 0xFF, s, &vx, &vy);
+        if (!PART_spawn(x, y, vx, vy, attr, life, flags)) return;
+    }
+}
+
+void PART_update(void) {
+    u16 i = 0;
+    while (i < count) {
+        if (flagsOf[i] & PART_GRAVITY) velY[i] += gravity;
+        posX[i] += velX[i];
+        posY[i] += velY[i];
+
+        s16 x = fix16ToInt(posX[i]);
+        s16 y = fix16ToInt(posY[i]);
+        bool gone = (--lives[i] == 0) || x <= -8 || x >= SCRN_W || y <= -8 || y >= SCRN_H;
+
+        if (gone) {
+            // Move the last live particle into this slot
+            u16 last = --count;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            attrs[i] = attrs[last];
+            lives[i] = lives[last];
+            flagsOf[i] = flagsOf[last];
+        } else {
+            i++;
+        }
+    }
+    spawnBudget = PART_SPAWN_BUDGET;
+}
+
+void PART_draw(void) {
+    u16 sprites = 0;
+
+    for (u16 i = 0; i < count; i++) {
+        s16 x = fix16ToInt(posX[i]);
+        s16 y = fix16ToInt(posY[i]);
+
+        if (!(flagsOf[i] & PART_SPRITE)) {
+            TMAP_setTile(attrs[i], (x + 4) >> 3, (y + 4) >> 3);
+        } else if (sprites < spriteMax) {
+            SPRL_add(x, y, SPRITE_SIZE(1, 1), attrs[i], FALSE);
+            sprites++;
+        }
+    }
+}
+
+u16 PART_count(void) {
+    return count;
+}
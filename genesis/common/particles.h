@@ -0,0 +1,51 @@
+/**
+ * Particles - shared by all Genesis games
+ *
+ * One fixed-capacity pool kept as parallel arrays (positions, fix16
+ * velocities, lifetimes, tile attributes). Live particles stay packed
+ * at the front, so update and draw only walk what is alive.
+ *
+ * Each particle is drawn either as a cell in the shadow tilemap (TMAP,
+ * snapped to the 8x8 grid, pairs well with an animated tile) or as an
+ * 8x8 hardware sprite at its exact pixel position, queued on the sprite
+ * layer (SPRL). Spawns beyond the per-frame budget or the pool size are
+ * dropped, and sprite particles beyond the cap given to PART_init are
+ * simply not drawn.
+ */
+
+#ifndef _COMMON_PARTICLES_H_
+#define _COMMON_PARTICLES_H_
+
+#include <genesis.h>
+
+#define PART_MAX            64
+// New particles accepted between two PART_update() calls
+#define PART_SPAWN_BUDGET   24
+
+// PART_spawn() / PART_burst() flags
+#define PART_SPRITE         0x01    // hardware sprite instead of a TMAP cell
+#define PART_GRAVITY        0x02    // falls with PART_setGravity()
+
+// Draw at most 'maxSprites' sprite particles per frame
+void PART_init(u16 maxSprites);
+// Kill everything
+void PART_clear(void);
+
+void PART_setGravity(fix16 gravity);
+
+// (x, y) is the top-left pixel, velocities are pixels per frame.
+// Returns FALSE if the particle was dropped.
+bool PART_spawn(s16 x, s16 y, fix16 vx, fix16 vy, u16 attr, u8 life, u8 flags);
+// 'num' particles flying out from (x, y) in random directions at
+// half to full 'speed'
+void PART_burst(s16 x, s16 y, u16 num, fix16 speed, u16 attr, u8 life, u8 flags);
+
+// Move and age everything, once per frame
+void PART_update(void);
+// Tile particles go into TMAP (call between TMAP_clear and TMAP_flush);
+// sprite particles are queued with SPRL_add (call before SPRL_flush)
+void PART_draw(void);
+
+u16 PART_count(void);
+
+#endif // _COMMON_PARTICLES_H_
@@ -0,0 +1,33 @@
+/**
+ * Entity pools - shared by all Genesis games
+ */
+
+#include "pool.h"
+
+void POOL_init(Pool* pool) {
+    // Lowest slots on top of the stack, so they are handed out first
+    for (u8 i = 0; i < pool->capacity; i++) {
+        pool->freeSlots[i] = pool->capacity - 1 - i;
+    }
+    pool->numFree = pool->capacity;
+    pool->numLive = 0;
+}
+
+u8 POOL_alloc(Pool* pool) {
+    if (!pool->numFree) return POOL_NONE;
+
+    u8 slot = pool->freeSlots[--pool->numFree];
+    pool->where[slot] = pool->numLive;
+    pool->live[pool->numLive++] = slot;
+    return slot;
+}
+
+void POOL_free(Pool* pool, u8 slot) {
+    // Move the last live slot into the freed place
+    u8 pos = pool->where[slot];
+    u8 last = pool->live[--pool->numLive];
+    pool->live[pos] = last;
+    pool->where[last] = pos;
+
+    pool->freeSlots[pool->numFree++] = slot;
+}
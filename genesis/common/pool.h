@@ -0,0 +1,55 @@
+/**
+ * Entity pools - shared by all Genesis games
+ *
+ * Slot bookkeeping for a fixed array of entities. The game keeps its
+ * entity data in its own arrays (or array of structs) and a pool hands
+ * out slot indices: a free stack makes POOL_alloc / POOL_free O(1), and
+ * the live slots are kept packed in a dense list so update, draw and
+ * collision loops only visit what is alive, whatever the capacity.
+ *
+ *   POOL_DEFINE(bullets, MAX_BULLETS);
+ *   u8 i = POOL_alloc(&bullets);    // POOL_NONE if full
+ *   for (u16 n = POOL_COUNT(&bullets); n--; ) {
+ *       u8 i = POOL_AT(&bullets, n);
+ *       ...                         // may POOL_free(&bullets, i)
+ *   }
+ *
+ * Freeing moves the last live slot into the freed place, so walk the
+ * live list backwards when freeing inside the loop. Order of the live
+ * list is not the order of allocation. Capacity is at most 255.
+ */
+
+#ifndef _COMMON_POOL_H_
+#define _COMMON_POOL_H_
+
+#include <genesis.h>
+
+#define POOL_NONE   0xFF
+
+typedef struct {
+    u8* freeSlots;      // stack of free slots
+    u8* live;           // packed live slots
+    u8* where;          // position of each live slot in 'live'
+    u8 capacity;
+    u8 numFree;
+    u8 numLive;
+} Pool;
+
+// A pool named 'name' over 'capacity' slots, with its own storage.
+// Call POOL_init before first use.
+#define POOL_DEFINE(name, capacity)                                         \
+    static u8 name##FreeSlots[capacity], name##Live[capacity], name##Where[capacity]; \
+    static Pool name = { name##FreeSlots, name##Live, name##Where, capacity, 0, 0 }
+
+#define POOL_COUNT(pool)    ((pool)->numLive)
+#define POOL_AT(pool, n)    ((pool)->live[n])
+#define POOL_FULL(pool)     ((pool)->numFree == 0)
+
+// Free every slot
+void POOL_init(Pool* pool);
+// Take a free slot, POOL_NONE if there is none
+u8 POOL_alloc(Pool* pool);
+// Give a live slot back
+void POOL_free(Pool* pool, u8 slot);
+
+#endif // _COMMON_POOL_H_
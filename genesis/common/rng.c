@@ -0,0 +1,38 @@
+/**
+ * Random numbers - shared by all Genesis games
+ */
+
+#include "rng.h"
+
+// Used in place of a zero seed
+#define RNG_DEFAULT_SEED    0xACE1
+
+static u16 state[RNG_STREAMS];
+
+void RNG_init(u16 seed) {
+    // Spread the streams apart so they do not start in step
+    for (u16 i = 0; i < RNG_STREAMS; i++) {
+        RNG_seed(i, seed + i * 0x9E37);
+    }
+}
+
+void RNG_seed(u16 stream, u16 seed) {
+    state[stream] = seed ? seed : RNG_DEFAULT_SEED;
+}
+
+u16 RNG_next(u16 stream) {
+    u16 s = state[stream];
+    s ^= s << 7;
+    s ^= s >> 9;
+    s ^= s << 8;
+    state[stream] = s;
+    return s;
+}
+
+u16 RNG_range(u16 stream, u16 n) {
+    return ((u32)RNG_next(stream) * n) >> 16;
+}
+
+bool RNG_chance(u16 stream, u16 n) {
+    return RNG_range(stream, n) == 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * Random numbers - shared by all Genesis games
+ *
+ * 16-bit xorshift generators: three shifts and three XORs per draw, no
+ * multiply. Randomness is split into streams so cosmetic draws (sound
+ * pitch, debris, shake) never move the gameplay or AI sequences: call
+ * RNG_init when a game starts and, given the same seed and input, the
+ * game plays out the same way again whatever the effects did.
+ *
+ * Bounded draws scale by multiply-shift instead of '%', one MULU. The
+ * bias is at most n / 65536, fine for picking spawn points and odds.
+ */
+
+#ifndef _COMMON_RNG_H_
+#define _COMMON_RNG_H_
+
+#include <genesis.h>
+
+// Streams
+#define RNG_GAME        0   // gameplay: spawns, pieces, layouts
+#define RNG_AI          1   // computer players' decisions
+#define RNG_FX          2   // cosmetic only
+#define RNG_STREAMS     3
+
+// Seed every stream from 'seed'
+void RNG_init(u16 seed);
+// Restart one stream; 0 is not a valid xorshift state and is replaced
+void RNG_seed(u16 stream, u16 seed);
+
+// Next 16-bit value
+u16 RNG_next(u16 stream);
+// Value in [0, n)
+u16 RNG_range(u16 stream, u16 n);
+// TRUE one time in 'n'
+bool RNG_chance(u16 stream, u16 n);
+
+#endif // _COMMON_RNG_H_
@@ -0,0 +1,87 @@
+/**
+ * Frame scheduler - shared by all Genesis games
+ */
+
+#include "sched.h"
+
+// Lines below this are the visible display in V28
+#define SCHED_DISPLAY_LINES 224
+
+typedef struct {
+    VoidCallback* run;
+    u16 cost;       // expected scanlines, 8.8 fixed point
+    u32 skipped;
+} OptionalTask;
+
+static OptionalTask tasks[SCHED_MAX_TASKS];
+static u16 numTasks;
+static u16 deadline;
+static u32 overruns;
+static u32 lastVTimer;
+
+void SCHED_init(u16 line) {
+    memset(tasks, 0, sizeof(tasks));
+    numTasks = 0;
+    deadline = line ? line : SCHED_DEADLINE;
+    overruns = 0;
+    lastVTimer = vtimer;
+}
+
+u16 SCHED_addTask(VoidCallback* task, u16 cost) {
+    if (numTasks >= SCHED_MAX_TASKS) {
+        SYS_die("SCHED: too many tasks");
+        return 0;
+    }
+    tasks[numTasks].run = task;
+    tasks[numTasks].cost = cost << 8;
+    tasks[numTasks].skipped = 0;
+    return numTasks++;
+}
+
+void SCHED_beginFrame(void) {
+    // vtimer counts vblanks; more than one since last frame = a missed one
+    if (vtimer - lastVTimer > 1) overruns++;
+    lastVTimer = vtimer;
+}
+
+u16 SCHED_getLine(void) {
+    // The counter jumps around during vblank (and wraps on PAL), so only
+    // trust it while the display is being drawn
+    if (GET_VDP_STATUS(VDP_VBLANK_FLAG)) return 0;
+    u16 line = GET_VCOUNTER;
+    return (line < SCHED_DISPLAY_LINES) ? line : 0;
+}
+
+bool SCHED_hasBudget(u16 lines) {
+    return SCHED_getLine() + lines < deadline;
+}
+
+void SCHED_runOptional(void) {
+    for (u16 i = 0; i < numTasks; i++) {
+        OptionalTask* t = &tasks[i];
+        u16 start = SCHED_getLine();
+
+        if (start + ((t->cost + 0xFF) >> 8) >= deadline) {
+            t->skipped++;
+            // Let the estimate creep down so one slow frame is not final
+            t->cost -= t->cost >> 3;
+            continue;
+        }
+
+        t->run();
+
+        // Running average of the measured cost, 1/4 weight per frame.
+        // Running into vblank reads as line 0: count the rest of the display.
+        u16 end = SCHED_getLine();
+        u16 used = (end >= start) ? end - start : SCHED_DISPLAY_LINES - start;
+        t->cost = t->cost - (t->cost >> 2) + (used << 6);
+    }
+}
+
+u32 SCHED_getSkipped(u16 id) {
+    return (id < numTasks) ? tasks[id].skipped : 0;
+}
+
+u32 SCHED_getOverruns(void) {
+    return overruns;
+}
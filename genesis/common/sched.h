@@ -0,0 +1,47 @@
+/**
+ * Frame scheduler - shared by all Genesis games
+ *
+ * Keeps cosmetic work from making the game miss vblank. The main loop
+ * runs its essential work (input, simulation, collision) directly, then
+ * SCHED_runOptional() runs the registered optional tasks in priority
+ * order for as long as the frame's scanline budget allows. Budget is
+ * read from the VDP V-counter; each task's cost is learnt from how many
+ * lines it took on previous frames.
+ *
+ * Tasks that did not fit are skipped for that frame and counted, and
+ * so are frames where the loop missed a vblank altogether.
+ */
+
+#ifndef _COMMON_SCHED_H_
+#define _COMMON_SCHED_H_
+
+#include <genesis.h>
+
+#define SCHED_MAX_TASKS     8
+
+// Default last scanline optional work may run to, leaving the rest of
+// the display for drawing and TMAP_flush()
+#define SCHED_DEADLINE      192
+
+// Forget all tasks and counters; 'deadline' 0 means SCHED_DEADLINE
+void SCHED_init(u16 deadline);
+
+// Register an optional task (first added runs first) with a starting
+// cost estimate in scanlines. Returns the task id.
+u16 SCHED_addTask(VoidCallback* task, u16 cost);
+
+// Call once per frame, right after SYS_doVBlankProcess()
+void SCHED_beginFrame(void);
+// Run optional tasks while they fit before the deadline
+void SCHED_runOptional(void);
+
+// Current display line, 0 while still in vblank
+u16 SCHED_getLine(void);
+// TRUE if 'lines' more scanlines of work fit before the deadline
+bool SCHED_hasBudget(u16 lines);
+
+// Frames task 'id' was skipped, and frames that missed a vblank
+u32 SCHED_getSkipped(u16 id);
+u32 SCHED_getOverruns(void);
+
+#endif // _COMMON_SCHED_H_
@@ -0,0 +1,40 @@
+/**
+ * Scratch arena - shared by all Genesis games
+ */
+
+#include "scratch.h"
+
+// u16 so every allocation starts on a word boundary
+static u16 buffer[SCRATCH_SIZE / 2];
+static u16 used;
+static u16 highWater;
+
+void SCRATCH_reset(void) {
+    used = 0;
+}
+
+void* SCRATCH_alloc(u16 size) {
+    size = (size + 1) & ~1;
+    if (size > SCRATCH_SIZE - used) SYS_die("Scratch arena overflow");
+
+    void* p = (u8*)buffer + used;
+    used += size;
+    if (used > highWater) highWater = used;
+    return p;
+}
+
+u16 SCRATCH_mark(void) {
+    return used;
+}
+
+void SCRATCH_release(u16 mark) {
+    if (mark < used) used = mark;
+}
+
+u16 SCRATCH_getUsed(void) {
+    return used;
+}
+
+u16 SCRATCH_getHighWater(void) {
+    return highWater;
+}
@@ -0,0 +1,52 @@
+/**
+ * Scratch arena - shared by all Genesis games
+ *
+ * Transient buffers (AI searches, path queues, collision candidates,
+ * DMA sources for one-off screens) come from one bump allocator instead
+ * of each owning a static array for the life of the game. Allocating is
+ * a pointer bump; nothing is freed one by one.
+ *
+ * The main loop calls SCRATCH_reset() once per frame, right after
+ * SYS_doVBlankProcess(), so anything allocated lives until the end of
+ * the frame. Code that needs memory only for one call takes a mark and
+ * releases back to it.
+ *
+ * Scratch memory handed to DMA_queueDma() is read by the VDP during the
+ * next SYS_doVBlankProcess(), so it must stay untouched until then:
+ * never release a mark over it, and never reset the arena anywhere but
+ * after the vblank.
+ *
+ *   u16 mark = SCRATCH_mark();
+ *   Node* open = SCRATCH_NEW(Node, 64);
+ *   ...
+ *   SCRATCH_release(mark);
+ *
+ * Running out is a bug, not a condition to handle: the game stops with
+ * SYS_die(). The high-water mark says how much of SCRATCH_SIZE the
+ * worst frame used.
+ */
+
+#ifndef _COMMON_SCRATCH_H_
+#define _COMMON_SCRATCH_H_
+
+#include <genesis.h>
+
+#define SCRATCH_SIZE    5120    // bytes; a full text screen is 3.5 KB
+
+#define SCRATCH_NEW(type, n)    ((type*)SCRATCH_alloc(sizeof(type) * (n)))
+
+// Free everything; once per frame, never mid-frame
+void SCRATCH_reset(void);
+
+// 'size' bytes, word aligned and not cleared. Never NULL.
+void* SCRATCH_alloc(u16 size);
+
+// Free everything allocated after the mark was taken
+u16 SCRATCH_mark(void);
+void SCRATCH_release(u16 mark);
+
+// Bytes in use now, and the most ever in use
+u16 SCRATCH_getUsed(void);
+u16 SCRATCH_getHighWater(void);
+
+#endif // _COMMON_SCRATCH_H_
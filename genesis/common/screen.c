@@ -0,0 +1,39 @@
+/**
+ * Text screens - shared by all Genesis games
+ */
+
+#include "screen.h"
+#include "scratch.h"
+#include "tilemap.h"
+
+// Widest plane SGDK sets up; rows are laid out at the plane's own width
+// so the whole screen is one contiguous VRAM block
+#define SCRN_MAX_PLANE_W    64
+
+void SCRN_load(VDPPlane plane, const ScreenText* layout) {
+    u16 stride = VDP_getPlaneWidth();
+    if (stride > SCRN_MAX_PLANE_W) stride = SCRN_MAX_PLANE_W;
+    u16 base = TILE_ATTR_FULL(VDP_getTextPalette(), VDP_getTextPriority(), FALSE, FALSE, TILE_FONT_INDEX);
+
+    // DMA source, must stay untouched until the queued transfer has run;
+    // scratch memory lasts the frame, which is as long as that takes
+    u16* map = SCRATCH_NEW(u16, stride * TMAP_H);
+
+    memset(map, 0, stride * TMAP_H * 2);
+    for (const ScreenText* line = layout; line->text; line++) {
+        if ((u16)line->y >= TMAP_H) continue;
+
+        u16* row = &map[line->y * stride];
+        s16 x = line->x;
+        for (const char* s = line->text; *s; s++, x++) {
+            u8 c = *s;
+            if ((u16)x < TMAP_W && c >= 32) row[x] = base + (c - 32);
+        }
+    }
+
+    u16 addr = VDP_getPlaneAddress(plane, 0, 0);
+    u16 len = stride * TMAP_H;
+    if (!DMA_queueDma(DMA_VRAM, map, addr, len, 2)) {
+        DMA_doDma(DMA_VRAM, map, addr, len, 2);
+    }
+}
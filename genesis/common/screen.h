@@ -0,0 +1,35 @@
+/**
+ * Text screens - shared by all Genesis games
+ *
+ * Title and game-over screens are laid out as tables of text lines.
+ * SCRN_load() builds the whole screen in RAM once, at state entry, and
+ * sends it as one DMA covering the plane, so the per-frame draw only
+ * has to handle what moves or blinks.
+ *
+ * Text uses SGDK's font tiles with the current text palette. A line may
+ * point at a RAM buffer (high score, final score...); its contents are
+ * read at SCRN_load() time.
+ */
+
+#ifndef _COMMON_SCREEN_H_
+#define _COMMON_SCREEN_H_
+
+#include <genesis.h>
+
+typedef struct {
+    s16 x, y;
+    const char* text;
+} ScreenText;
+
+// Visible display in pixels (H40, 224 lines)
+#define SCRN_W      320
+#define SCRN_H      224
+
+// Ends a layout table
+#define SCRN_END    { 0, 0, NULL }
+
+// Replace the visible part of 'plane' with the layout (everything else
+// on screen becomes blank)
+void SCRN_load(VDPPlane plane, const ScreenText* layout);
+
+#endif // _COMMON_SCREEN_H_
@@ -0,0 +1,167 @@
+/**
+ * Scroll effects - shared by all Genesis games
+ */
+
+#include "scroll.h"
+#include "rng.h"
+#include "trig.h"
+#include "vblank.h"
+
+#define SCRL_NUM_LAYERS 2
+#define SCRL_MAX_LINES  240
+#define SCRL_COLUMNS    20      // 2-cell columns in H40
+
+// Wave shapes are one 64-step sine period (every 4th trig angle)
+#define WAVE_STEPS      64
+#define WAVE_MASK       (WAVE_STEPS - 1)
+#define RIPPLE_SPEED    4       // pixels the ring grows per frame
+#define RIPPLE_WIDTH    WAVE_STEPS
+
+// Amplitudes are 8.8 fixed point so they can fade over any duration
+typedef struct {
+    u16 amp;
+    u16 decay;
+} Fade;
+
+typedef struct {
+    Fade shake;
+    Fade wobble;
+    u8 wobblePhase;
+    Fade ripple;
+    s16 rippleX, rippleY;
+    u16 rippleRadius;
+} LayerFx;
+
+static LayerFx fx[SCRL_NUM_LAYERS];
+
+// Same layout as VRAM / VSRAM: plane A then plane B for each line / column
+static s16 hscroll[SCRL_MAX_LINES][SCRL_NUM_LAYERS];
+static s16 vscroll[SCRL_COLUMNS][SCRL_NUM_LAYERS];
+static u16 lines;
+static bool settled;    // tables are all zero and already uploaded
+
+static void startFade(Fade* f, u16 amplitude, u16 frames) {
+    f->amp = amplitude << 8;
+    f->decay = f->amp / (frames ? frames : 1);
+    if (f->decay == 0) f->decay = 1;
+}
+
+// Current whole-pixel amplitude, then fade one frame
+static u16 stepFade(Fade* f) {
+    u16 amp = (f->amp + 0xFF) >> 8;
+    f->amp = (f->amp > f->decay) ? f->amp - f->decay : 0;
+    return amp;
+}
+
+// One sine period scaled to 'amp' pixels
+static void scaleWave(s16* wave, u16 amp) {
+    for (u16 i = 0; i < WAVE_STEPS; i++) wave[i] = ((s32)TRIG_sin(i << 2) * amp) >> 14;
+}
+
+static bool buildLayer(u16 l) {
+    LayerFx* f = &fx[l];
+    s16 dx = 0, dy = 0;
+    s16 wobble[WAVE_STEPS];
+    s16 ripple[WAVE_STEPS];
+
+    bool active = f->shake.amp || f->wobble.amp || f->ripple.amp;
+    if (!active) {
+        for (u16 y = 0; y < lines; y++) hscroll[y][l] = 0;
+        for (u16 c = 0; c < SCRL_COLUMNS; c++) vscroll[c][l] = 0;
+        return FALSE;
+    }
+
+    if (f->shake.amp) {
+        u16 amp = stepFade(&f->shake);
+        u16 range = amp * 2 + 1;
+        dx = (s16)RNG_range(RNG_FX, range) - amp;
+        dy = (s16)RNG_range(RNG_FX, range) - amp;
+    }
+
+    u16 wobbleAmp = f->wobble.amp ? stepFade(&f->wobble) : 0;
+    if (wobbleAmp) scaleWave(wobble, wobbleAmp);
+
+    u16 rippleAmp = f->ripple.amp ? stepFade(&f->ripple) : 0;
+    if (rippleAmp) scaleWave(ripple, rippleAmp);
+    u16 radius = f->rippleRadius;
+
+    for (u16 y = 0; y < lines; y++) {
+        s16 x = dx;
+        if (wobbleAmp) x += wobble[(y + f->wobblePhase) & WAVE_MASK];
+        if (rippleAmp) {
+            u16 d = abs((s16)y - f->rippleY);
+            // Only the band just inside the expanding ring moves
+            if (d < radius && radius - d < RIPPLE_WIDTH) x += ripple[radius - d];
+        }
+        hscroll[y][l] = x;
+    }
+
+    for (u16 c = 0; c < SCRL_COLUMNS; c++) {
+        s16 y = dy;
+        if (rippleAmp) {
+            u16 d = abs((s16)(c * 16 + 8) - f->rippleX);
+            if (d < radius && radius - d < RIPPLE_WIDTH) y += ripple[radius - d];
+        }
+        vscroll[c][l] = y;
+    }
+
+    f->wobblePhase += 2;
+    if (rippleAmp) f->rippleRadius += RIPPLE_SPEED;
+    return TRUE;
+}
+
+static void update(void) {
+    bool active = FALSE;
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (fx[l].shake.amp || fx[l].wobble.amp || fx[l].ripple.amp) active = TRUE;
+    }
+    if (!active && settled) return;
+
+    active = FALSE;
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (buildLayer(l)) active = TRUE;
+    }
+    // The all-zero tables still go out once so the planes come to rest
+    settled = !active;
+
+    DMA_doDma(DMA_VRAM, hscroll, VDP_getHScrollTableAddress(), lines * SCRL_NUM_LAYERS, 2);
+    DMA_doDma(DMA_VSRAM, vscroll, 0, SCRL_COLUMNS * SCRL_NUM_LAYERS, 2);
+}
+
+void SCRL_init(void) {
+    lines = VDP_getScreenHeight();
+    if (lines > SCRL_MAX_LINES) lines = SCRL_MAX_LINES;
+
+    memset(fx, 0, sizeof(fx));
+    settled = FALSE;
+    VDP_setScrollingMode(HSCROLL_LINE, VSCROLL_COLUMN);
+    VBL_addTask(update);
+}
+
+void SCRL_shake(u16 layers, u16 amplitude, u16 frames) {
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (layers & (1 << l)) startFade(&fx[l].shake, amplitude, frames);
+    }
+}
+
+void SCRL_wobble(u16 layers, u16 amplitude, u16 frames) {
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (layers & (1 << l)) startFade(&fx[l].wobble, amplitude, frames);
+    }
+}
+
+void SCRL_ripple(u16 layers, s16 x, s16 y, u16 amplitude, u16 frames) {
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (!(layers & (1 << l))) continue;
+        startFade(&fx[l].ripple, amplitude, frames);
+        fx[l].rippleX = x;
+        fx[l].rippleY = y;
+        fx[l].rippleRadius = 0;
+    }
+}
+
+void SCRL_stop(u16 layers) {
+    for (u16 l = 0; l < SCRL_NUM_LAYERS; l++) {
+        if (layers & (1 << l)) memset(&fx[l], 0, sizeof(LayerFx));
+    }
+}
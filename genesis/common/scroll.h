@@ -0,0 +1,36 @@
+/**
+ * Scroll effects - shared by all Genesis games
+ *
+ * Puts the VDP in per-line horizontal / per-column vertical scrolling and
+ * drives both planes from RAM tables. A vblank task steps the active
+ * effects, rebuilds the tables and uploads each with a single DMA
+ * (nothing is sent once everything has settled back to zero).
+ *
+ * Effects are kept per layer and add up:
+ *   shake   random offset on both axes, amplitude decaying to zero
+ *   wobble  horizontal sine wave rolling down the screen, decaying
+ *   ripple  wave spreading out from an impact point, decaying
+ */
+
+#ifndef _COMMON_SCROLL_H_
+#define _COMMON_SCROLL_H_
+
+#include <genesis.h>
+
+#define SCRL_LAYER_A    0x0001
+#define SCRL_LAYER_B    0x0002
+#define SCRL_LAYERS     (SCRL_LAYER_A | SCRL_LAYER_B)
+
+// Switches the scrolling mode and zeroes both planes
+void SCRL_init(void);
+
+// Amplitudes are in pixels, durations in frames
+void SCRL_shake(u16 layers, u16 amplitude, u16 frames);
+void SCRL_wobble(u16 layers, u16 amplitude, u16 frames);
+// Impact at screen pixel (x, y)
+void SCRL_ripple(u16 layers, s16 x, s16 y, u16 amplitude, u16 frames);
+
+// Cancel every effect on these layers
+void SCRL_stop(u16 layers);
+
+#endif // _COMMON_SCROLL_H_
@@ -0,0 +1,113 @@
+/**
+ * PSG sound effects - shared by all Genesis games
+ */
+
+#include "sfx.h"
+#include "vblank.h"
+
+#define NOISE_CHANNEL   3
+
+typedef struct {
+    const Sfx* sfx;         // NULL while the channel is free
+    const SfxStep* step;
+    s16 pitch;
+    u16 freq;
+    u8 volume;
+    u8 frames;              // left in this step
+    u8 fadeTimer;
+} Voice;
+
+static Voice voices[SFX_CHANNELS];
+
+static void setVolume(u16 ch, u8 volume) {
+    PSG_setEnvelope(ch, PSG_ENVELOPE_MIN - volume);
+}
+
+static void release(u16 ch) {
+    voices[ch].sfx = NULL;
+    setVolume(ch, 0);
+}
+
+// Load the voice's current step into the PSG, FALSE at the end of the script
+static bool startStep(u16 ch) {
+    Voice* v = &voices[ch];
+    const SfxStep* s = v->step;
+    if (!s->frames) return FALSE;
+
+    v->frames = s->frames;
+    v->volume = s->volume;
+    v->fadeTimer = 0;
+    if (ch == NOISE_CHANNEL) {
+        PSG_setNoise(s->freq >> 2, s->freq & 3);
+    } else if (s->freq) {
+        v->freq = s->freq + v->pitch;
+        PSG_setFrequency(ch, v->freq);
+    } else {
+        v->volume = 0;
+    }
+    setVolume(ch, v->volume);
+    return TRUE;
+}
+
+static void update(void) {
+    for (u16 ch = 0; ch < SFX_CHANNELS; ch++) {
+        Voice* v = &voices[ch];
+        if (!v->sfx) continue;
+
+        if (--v->frames == 0) {
+            v->step++;
+            if (!startStep(ch)) release(ch);
+            continue;
+        }
+
+        const SfxStep* s = v->step;
+        if (s->slide && ch != NOISE_CHANNEL && v->volume) {
+            v->freq += s->slide;
+            PSG_setFrequency(ch, v->freq);
+        }
+        if (s->fade && v->volume && ++v->fadeTimer >= s->fade) {
+            v->fadeTimer = 0;
+            setVolume(ch, --v->volume);
+        }
+    }
+}
+
+void SFX_init(void) {
+    for (u16 ch = 0; ch < SFX_CHANNELS; ch++) release(ch);
+    VBL_addTask(update);
+}
+
+bool SFX_play(const Sfx* sfx) {
+    return SFX_playPitch(sfx, 0);
+}
+
+bool SFX_playPitch(const Sfx* sfx, s16 pitch) {
+    // Free channel first, else the least important one it may steal
+    s16 ch = -1;
+    if (sfx->noise) {
+        Voice* v = &voices[NOISE_CHANNEL];
+        if (!v->sfx || v->sfx->priority <= sfx->priority) ch = NOISE_CHANNEL;
+    } else {
+        for (u16 i = 0; i < NOISE_CHANNEL; i++) {
+            Voice* v = &voices[i];
+            if (!v->sfx) {
+                ch = i;
+                break;
+            }
+            if (v->sfx->priority <= sfx->priority &&
+                (ch < 0 || v->sfx->priority < voices[ch].sfx->priority)) ch = i;
+        }
+    }
+    if (ch < 0) return FALSE;
+
+    Voice* v = &voices[ch];
+    v->sfx = sfx;
+    v->step = sfx->steps;
+    v->pitch = pitch;
+    if (!startStep(ch)) release(ch);
+    return TRUE;
+}
+
+void SFX_stopAll(void) {
+    for (u16 ch = 0; ch < SFX_CHANNELS; ch++) release(ch);
+}
@@ -0,0 +1,63 @@
+/**
+ * PSG sound effects - shared by all Genesis games
+ *
+ * Effects are ROM scripts of steps (a note or noise, its volume and how
+ * many frames it lasts, with optional pitch slide and fade) played by a
+ * vblank task, so starting one costs a few register writes and nothing
+ * ever waits on a sound.
+ *
+ * Tone effects take any of the three tone channels and noise effects
+ * the noise channel. When none is free the effect steals the channel
+ * with the lowest priority, if that is no higher than its own; a
+ * channel is released and silenced as soon as its script ends.
+ *
+ *   static const SfxStep shootSteps[] = { { 1200, 15, 6, 0, 2 }, SFX_END };
+ *   static const Sfx sfxShoot = { SFX_PRIO_LOW, FALSE, shootSteps };
+ *   SFX_play(&sfxShoot);
+ */
+
+#ifndef _COMMON_SFX_H_
+#define _COMMON_SFX_H_
+
+#include <genesis.h>
+
+#define SFX_CHANNELS    4   // 3 tone + noise
+
+// Suggested priorities
+#define SFX_PRIO_LOW    1   // blips, moves
+#define SFX_PRIO_MID    2   // hits
+#define SFX_PRIO_HIGH   3   // explosions, clears
+#define SFX_PRIO_JINGLE 4   // deaths, fanfares
+
+// Noise channel setting for SfxStep.freq
+#define SFX_NOISE(type, rate)   (((type) << 2) | (rate))
+
+typedef struct {
+    u16 freq;       // Hz (0 rests), or SFX_NOISE() on the noise channel
+    u8 volume;      // 0 silent to 15 loudest, at the start of the step
+    u8 frames;      // length of the step, 0 ends the script
+    s8 slide;       // Hz added every frame
+    u8 fade;        // frames per volume step down, 0 holds
+} SfxStep;
+
+#define SFX_END     { 0, 0, 0, 0, 0 }
+
+typedef struct {
+    u8 priority;
+    bool noise;             // plays on the noise channel
+    const SfxStep* steps;
+} Sfx;
+
+// Silence every channel and hook the vblank task
+void SFX_init(void);
+
+// Start an effect; FALSE if every channel it could use is busy with
+// something more important
+bool SFX_play(const Sfx* sfx);
+// Same, with 'pitch' Hz added to every tone step
+bool SFX_playPitch(const Sfx* sfx, s16 pitch);
+
+// Silence and release every channel
+void SFX_stopAll(void);
+
+#endif // _COMMON_SFX_H_
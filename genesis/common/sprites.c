@@ -0,0 +1,123 @@
+/**
+ * Sprite layer - shared by all Genesis games
+ */
+
+#include "sprites.h"
+#include "scratch.h"
+#include "screen.h"
+
+typedef struct {
+    s16 x, y;
+    u16 attr;
+    u8 size;
+    u8 keep;
+} QueuedSprite;
+
+static QueuedSprite queue[SPRL_MAX_QUEUED];
+static u16 numQueued;
+
+// Sprites in the table being built
+static u16 numSprites;
+// Queue index the next flush starts from (0 unless the last one overflowed)
+static u16 rotation;
+static u16 dropped;
+
+// Sprites and sprite cells already on each display line, in scratch
+// memory for the length of a flush
+static u8* lineSprites;
+static u8* lineCells;
+
+void SPRL_init(void) {
+    numQueued = 0;
+    rotation = 0;
+    SPRL_flush();
+}
+
+bool SPRL_add(s16 x, s16 y, u8 size, u16 attr, bool keep) {
+    if (numQueued >= SPRL_MAX_QUEUED) return FALSE;
+
+    QueuedSprite* s = &queue[numQueued++];
+    s->x = x;
+    s->y = y;
+    s->attr = attr;
+    s->size = size;
+    s->keep = keep;
+    return TRUE;
+}
+
+// Sprites off screen still count against the line limits, leave them out
+static bool isVisible(const QueuedSprite* s) {
+    s16 w = (((s->size >> 2) & 3) + 1) << 3;
+    s16 h = ((s->size & 3) + 1) << 3;
+    return s->x + w > 0 && s->x < SCRN_W && s->y + h > 0 && s->y < SCRN_H;
+}
+
+// Claim room on every line the sprite covers, or nothing if one is full
+static bool claimLines(const QueuedSprite* s) {
+    u8 cells = ((s->size >> 2) & 3) + 1;
+    s16 top = s->y;
+    s16 bottom = top + (((s->size & 3) + 1) << 3);
+    if (top < 0) top = 0;
+    if (bottom > SCRN_H) bottom = SCRN_H;
+
+    for (s16 y = top; y < bottom; y++) {
+        if (lineSprites[y] >= SPRL_LINE_SPRITES || lineCells[y] + cells > SPRL_LINE_CELLS) return FALSE;
+    }
+    for (s16 y = top; y < bottom; y++) {
+        lineSprites[y]++;
+        lineCells[y] += cells;
+    }
+    return TRUE;
+}
+
+static bool place(const QueuedSprite* s) {
+    if (numSprites >= SPRL_MAX_SPRITES || !claimLines(s)) return FALSE;
+
+    // Link to the next one; the last link is patched by the flush
+    VDP_setSpriteFull(numSprites, s->x, s->y, s->size, s->attr, numSprites + 1);
+    numSprites++;
+    return TRUE;
+}
+
+void SPRL_flush(void) {
+    u16 mark = SCRATCH_mark();
+    lineSprites = SCRATCH_NEW(u8, SCRN_H);
+    lineCells = SCRATCH_NEW(u8, SCRN_H);
+    memset(lineSprites, 0, SCRN_H);
+    memset(lineCells, 0, SCRN_H);
+    numSprites = 0;
+    dropped = 0;
+
+    for (u16 i = 0; i < numQueued; i++) {
+        const QueuedSprite* s = &queue[i];
+        if (s->keep && isVisible(s) && !place(s)) dropped++;
+    }
+
+    // The rest, starting with the first one left out last frame
+    u16 firstDropped = numQueued;
+    u16 i = (rotation < numQueued) ? rotation : 0;
+    for (u16 n = numQueued; n; n--) {
+        const QueuedSprite* s = &queue[i];
+        if (!s->keep && isVisible(s) && !place(s)) {
+            if (firstDropped == numQueued) firstDropped = i;
+            dropped++;
+        }
+        if (++i == numQueued) i = 0;
+    }
+    rotation = (firstDropped < numQueued) ? firstDropped : 0;
+
+    if (numSprites) {
+        vdpSpriteCache[numSprites - 1].size_link &= 0xFF00;
+    } else {
+        // The table always has one entry: park it off screen
+        VDP_setSpriteFull(0, -32, -32, SPRITE_SIZE(1, 1), 0, 0);
+        numSprites = 1;
+    }
+    VDP_updateSprites(numSprites, DMA_QUEUE);
+    numQueued = 0;
+    SCRATCH_release(mark);
+}
+
+u16 SPRL_getDropped(void) {
+    return dropped;
+}
@@ -0,0 +1,45 @@
+/**
+ * Sprite layer - shared by all Genesis games
+ *
+ * Games queue the hardware sprites they want each frame with SPRL_add()
+ * and call SPRL_flush() once, after drawing. The flush builds SGDK's RAM
+ * sprite table (vdpSpriteCache) and queues one DMA of it for the next
+ * vblank, so the VDP sees a complete table every frame.
+ *
+ * The VDP shows at most 80 sprites, and 20 sprites or 40 cells of sprite
+ * width on any scanline; past that it silently drops sprites. The flush
+ * enforces these limits itself, and when a frame has more than fits, the
+ * next frame starts from the first sprite that was left out. Overloaded
+ * scenes then flicker evenly instead of losing the same sprites forever.
+ * Sprites added with 'keep' are placed first and never take part in the
+ * rotation (player ship, ball...).
+ */
+
+#ifndef _COMMON_SPRITES_H_
+#define _COMMON_SPRITES_H_
+
+#include <genesis.h>
+
+// Requests per frame; more than the VDP can show so rotation has work
+#define SPRL_MAX_QUEUED     128
+
+// VDP limits in H40
+#define SPRL_MAX_SPRITES    80
+#define SPRL_LINE_SPRITES   20
+#define SPRL_LINE_CELLS     40
+
+// Forget queued sprites and hide everything
+void SPRL_init(void);
+
+// Queue a sprite for this frame at pixel position x, y. 'size' is a
+// SPRITE_SIZE(w, h), 'attr' a TILE_ATTR_FULL(). FALSE if the queue is full.
+bool SPRL_add(s16 x, s16 y, u8 size, u16 attr, bool keep);
+
+// Build the table from this frame's sprites, send it at the next vblank
+// and start an empty queue
+void SPRL_flush(void);
+
+// Sprites left out by the last flush
+u16 SPRL_getDropped(void);
+
+#endif // _COMMON_SPRITES_H_
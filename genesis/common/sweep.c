@@ -0,0 +1,74 @@
+/**
+ * Swept grid collision - shared by all Genesis games
+ */
+
+#include "sweep.h"
+
+// fix16 pixels to 8x8 cells
+#define CELL_SHIFT  (3 + FIX16_FRAC_BITS)
+#define CELL_SIZE   (1 << CELL_SHIFT)
+
+bool SWEEP_cast(fix16 x0, fix16 y0, fix16 x1, fix16 y1, SweepSolidFn* solid, SweepHit* hit) {
+    s16 cx = x0 >> CELL_SHIFT, cy = y0 >> CELL_SHIFT;
+    s16 ex = x1 >> CELL_SHIFT, ey = y1 >> CELL_SHIFT;
+    s16 dx = x1 - x0, dy = y1 - y0;
+    s16 stepX = (dx > 0) - (dx < 0);
+    s16 stepY = (dy > 0) - (dy < 0);
+    s32 adx = abs(dx), ady = abs(dy);
+
+    // Distance along each axis to the next cell boundary
+    s32 bx = (stepX > 0) ? ((s32)(cx + 1) << CELL_SHIFT) - x0 : x0 - ((s32)cx << CELL_SHIFT);
+    s32 by = (stepY > 0) ? ((s32)(cy + 1) << CELL_SHIFT) - y0 : y0 - ((s32)cy << CELL_SHIFT);
+
+    while (cx != ex || cy != ey) {
+        // The X boundary comes first if bx / adx < by / ady
+        bool alongX;
+        if (cx == ex) alongX = FALSE;
+        else if (cy == ey) alongX = TRUE;
+        else alongX = bx * ady < by * adx;
+
+        if (alongX) cx += stepX;
+        else cy += stepY;
+
+        if (solid(cx, cy)) {
+            hit->cellX = cx;
+            hit->cellY = cy;
+            if (alongX) {
+                hit->normalX = -stepX;
+                hit->normalY = 0;
+                hit->x = x0 + stepX * bx;
+                hit->y = y0 + (fix16)(((s32)dy * bx) / adx);
+            } else {
+                hit->normalX = 0;
+                hit->normalY = -stepY;
+                hit->x = x0 + (fix16)(((s32)dx * by) / ady);
+                hit->y = y0 + stepY * by;
+            }
+            return TRUE;
+        }
+
+        if (alongX) bx += CELL_SIZE;
+        else by += CELL_SIZE;
+    }
+    return FALSE;
+}
+
+bool SWEEP_move(KinBody* body, s16 offset, SweepSolidFn* solid, SweepHit* hit, bool bounce) {
+    fix16 off = intToFix16(offset);
+    fix16 x0 = body->x + off;
+    fix16 y0 = body->y + off;
+
+    if (!SWEEP_cast(x0, y0, x0 + body->vx, y0 + body->vy, solid, hit)) {
+        KIN_step(body);
+        return FALSE;
+    }
+
+    // Stop a hair outside the face that was hit
+    body->x = hit->x - off + hit->normalX;
+    body->y = hit->y - off + hit->normalY;
+    if (bounce) {
+        if (hit->normalX) body->vx = -body->vx;
+        else body->vy = -body->vy;
+    }
+    return TRUE;
+}
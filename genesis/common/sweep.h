@@ -0,0 +1,39 @@
+/**
+ * Swept grid collision - shared by all Genesis games
+ *
+ * Walks every 8x8 cell a point crosses between two positions, in order,
+ * and stops at the first one the game calls solid. Cells are stepped
+ * with an integer DDA: the next boundary on each axis is compared by
+ * cross-multiplying, so the walk needs no division and a fast mover can
+ * no longer jump over a one-cell wall. Only a hit pays for one division,
+ * to find where the path entered the cell.
+ *
+ * Cells are screen cells (pixel >> 3); the game's callback maps them to
+ * its own grid.
+ */
+
+#ifndef _COMMON_SWEEP_H_
+#define _COMMON_SWEEP_H_
+
+#include <genesis.h>
+#include "kinematics.h"
+
+// TRUE if screen cell (x, y) blocks the path
+typedef bool SweepSolidFn(s16 x, s16 y);
+
+typedef struct {
+    s16 cellX, cellY;       // the solid cell
+    s8 normalX, normalY;    // face that was hit, one of them is 0
+    fix16 x, y;             // where the path entered the cell
+} SweepHit;
+
+// Walk from (x0, y0) to (x1, y1), fix16 pixels. The start cell is never
+// tested. Fills 'hit' and returns TRUE at the first solid cell.
+bool SWEEP_cast(fix16 x0, fix16 y0, fix16 x1, fix16 y1, SweepSolidFn* solid, SweepHit* hit);
+
+// Step 'body' one frame, sweeping its point (x + offset, y + offset).
+// On a hit the body stops just outside the cell and, if 'bounce', its
+// velocity is mirrored off the face.
+bool SWEEP_move(KinBody* body, s16 offset, SweepSolidFn* solid, SweepHit* hit, bool bounce);
+
+#endif // _COMMON_SWEEP_H_
@@ -0,0 +1,101 @@
+/**
+ * Tile animations - shared by all Genesis games
+ */
+
+#include "tileanim.h"
+#include "vblank.h"
+
+#define TANIM_TILE_LONGS    8       // one 4bpp 8x8 pattern
+#define TANIM_TILE_WORDS    16
+
+typedef struct {
+    const u32* frames;
+    u16 tile;
+    u8 numFrames;
+    u8 frame;
+    u8 frameTime;
+    u8 timer;
+    bool loop;
+    bool playing;
+    bool dirty;     // 'frame' not in VRAM yet
+} TileAnim;
+
+static TileAnim anims[TANIM_MAX_SLOTS];
+static u16 numAnims;
+
+static void update(void) {
+    for (u16 i = 0; i < numAnims; i++) {
+        TileAnim* a = &anims[i];
+
+        if (a->playing && ++a->timer >= a->frameTime) {
+            a->timer = 0;
+            if (a->frame + 1 < a->numFrames) {
+                a->frame++;
+                a->dirty = TRUE;
+            } else if (a->loop) {
+                if (a->frame) a->dirty = TRUE;
+                a->frame = 0;
+            } else {
+                a->playing = FALSE;
+            }
+        }
+
+        if (a->dirty) {
+            a->dirty = FALSE;
+            DMA_doDma(DMA_VRAM, (void*)(a->frames + a->frame * TANIM_TILE_LONGS),
+                      a->tile * 32, TANIM_TILE_WORDS, 2);
+        }
+    }
+}
+
+void TANIM_init(void) {
+    memset(anims, 0, sizeof(anims));
+    numAnims = 0;
+    VBL_addTask(update);
+}
+
+u16 TANIM_add(u16 tile, const u32* frames, u16 numFrames, u16 frameTime, bool loop) {
+    if (numAnims >= TANIM_MAX_SLOTS) {
+        SYS_die("TANIM: too many slots");
+        return 0;
+    }
+
+    TileAnim* a = &anims[numAnims];
+    a->frames = frames;
+    a->tile = tile;
+    a->numFrames = numFrames ? numFrames : 1;
+    a->frame = 0;
+    a->frameTime = frameTime ? frameTime : 1;
+    a->timer = 0;
+    a->loop = loop;
+    a->playing = loop;
+    a->dirty = FALSE;
+    VDP_loadTileData(frames, tile, 1, CPU);
+    return numAnims++;
+}
+
+void TANIM_play(u16 slot) {
+    if (slot >= numAnims) return;
+    TileAnim* a = &anims[slot];
+    if (a->frame) a->dirty = TRUE;
+    a->frame = 0;
+    a->timer = 0;
+    a->playing = TRUE;
+}
+
+void TANIM_stop(u16 slot) {
+    if (slot < numAnims) anims[slot].playing = FALSE;
+}
+
+void TANIM_setFrame(u16 slot, u16 frame) {
+    if (slot >= numAnims) return;
+    TileAnim* a = &anims[slot];
+    if (frame >= a->numFrames) frame = a->numFrames - 1;
+    if (frame != a->frame) a->dirty = TRUE;
+    a->frame = frame;
+    a->timer = 0;
+}
+
+bool TANIM_isPlaying(u16 slot) {
+    return (slot < numAnims) && anims[slot].playing;
+}
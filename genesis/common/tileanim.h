@@ -0,0 +1,38 @@
+/**
+ * Tile animations - shared by all Genesis games
+ *
+ * Animates a tile by rewriting its pattern in VRAM instead of pointing
+ * map cells at another tile. Each effect owns one tile slot; a vblank
+ * task streams the slot's current frame (one 32-byte pattern) whenever
+ * the frame changes, so every cell using that tile animates together
+ * and the cost does not depend on how many are on screen.
+ *
+ * Frames are 8 u32 rows each, back to back, and are read in place, so
+ * they must stay uncompressed: a rescomp TILESET with NONE compression
+ * (pass its .tiles) or a const array.
+ */
+
+#ifndef _COMMON_TILEANIM_H_
+#define _COMMON_TILEANIM_H_
+
+#include <genesis.h>
+
+#define TANIM_MAX_SLOTS     8
+
+// Forget every slot and hook the vblank task
+void TANIM_init(void);
+
+// Give tile 'tile' an animation of 'numFrames' frames shown 'frameTime'
+// frames each. Frame 0 is loaded right away; looping animations start
+// playing, one-shots wait for TANIM_play. Returns the slot id.
+u16 TANIM_add(u16 tile, const u32* frames, u16 numFrames, u16 frameTime, bool loop);
+
+// Restart from frame 0 (one-shots stop on their last frame)
+void TANIM_play(u16 slot);
+// Hold the current frame
+void TANIM_stop(u16 slot);
+// Jump to a frame, shown from the next vblank
+void TANIM_setFrame(u16 slot, u16 frame);
+bool TANIM_isPlaying(u16 slot);
+
+#endif // _COMMON_TILEANIM_H_
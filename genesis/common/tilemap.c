@@ -0,0 +1,139 @@
+/**
+ * Shadow tilemap - shared by all Genesis games
+ */
+
+#include "tilemap.h"
+#include "vblank.h"
+#include "vram.h"
+
+// Unchanged cells between two dirty runs are resent rather than paying
+// for another DMA setup when the gap is this small
+#define TMAP_SPAN_GAP   4
+
+// What the game drew this frame
+static u16 back[TMAP_H][TMAP_W];
+// What each VRAM page holds once the queued DMA has run (and the DMA
+// source, so it must not change between TMAP_flush() and the vblank)
+static u16 front[2][TMAP_H][TMAP_W];
+
+static VDPPlane tmapPlane;
+static u16 textBase;
+static bool resendAll;
+
+// Double buffering: page 'drawPage' is hidden and receives the flush,
+// the vblank task then points plane A at it
+static bool doubleBuffer;
+static u16 pageAddr[2];
+static u16 rowStride;
+static u8 drawPage;
+static bool flipPending;
+
+static void flipPage(void) {
+    if (!flipPending) return;
+    flipPending = FALSE;
+
+    VDP_setBGAAddress(pageAddr[drawPage]);
+    drawPage ^= 1;
+}
+
+void TMAP_init(VDPPlane plane, u16 flags) {
+    tmapPlane = plane;
+    textBase = TILE_ATTR(VDP_getTextPalette(), VDP_getTextPriority(), FALSE, FALSE);
+
+    VDP_clearPlane(plane, TRUE);
+    memset(back, 0, sizeof(back));
+    memset(front, 0, sizeof(front));
+    resendAll = FALSE;
+
+    // Only plane A's base address can be flipped this way
+    doubleBuffer = (flags & TMAP_DOUBLE_BUFFER) && plane == BG_A;
+    rowStride = VDP_getPlaneWidth() * 2;
+    pageAddr[0] = VDP_getPlaneAddress(plane, 0, 0);
+    pageAddr[1] = VRAM_PAGE2_ADDR;
+    drawPage = 0;
+    flipPending = FALSE;
+
+    if (doubleBuffer) {
+        DMA_doVRamFill(pageAddr[1], VRAM_PAGE2_SIZE, 0, 1);
+        // Page 0 is on screen, so the first frame goes to page 1
+        drawPage = 1;
+        VBL_addTask(flipPage);
+    } else {
+        VBL_removeTask(flipPage);
+    }
+}
+
+void TMAP_clear(void) {
+    memset(back, 0, sizeof(back));
+}
+
+void TMAP_setTile(u16 attr, s16 x, s16 y) {
+    if ((u16)x >= TMAP_W || (u16)y >= TMAP_H) return;
+    back[y][x] = attr;
+}
+
+void TMAP_drawText(const char* str, s16 x, s16 y) {
+    TMAP_drawTextEx(str, textBase, x, y);
+}
+
+void TMAP_drawTextEx(const char* str, u16 basetile, s16 x, s16 y) {
+    if ((u16)y >= TMAP_H) return;
+
+    u16* cell = &back[y][0];
+    while (*str) {
+        u8 c = *str++;
+        if ((u16)x < TMAP_W) {
+            cell[x] = (c < 32) ? 0 : basetile + TILE_FONT_INDEX + (c - 32);
+        }
+        x++;
+    }
+}
+
+// Queue one row span; the DMA itself runs during the next vblank
+static void commitSpan(u16 x, u16 y, u16 len) {
+    u16* src = &front[drawPage][y][x];
+    u16 addr = pageAddr[drawPage] + y * rowStride + x * 2;
+    memcpy(src, &back[y][x], len * 2);
+
+    if (!DMA_queueDma(DMA_VRAM, src, addr, len, 2)) {
+        // Queue full: transfer right away instead
+        DMA_doDma(DMA_VRAM, src, addr, len, 2);
+    }
+}
+
+void TMAP_flush(void) {
+    for (u16 y = 0; y < TMAP_H; y++) {
+        const u16* b = back[y];
+        const u16* f = front[drawPage][y];
+        s16 start = -1;
+        u16 end = 0;
+
+        for (u16 x = 0; x < TMAP_W; x++) {
+            if (b[x] == f[x] && !resendAll) continue;
+
+            if (start < 0) {
+                start = x;
+            } else if (x - end > TMAP_SPAN_GAP) {
+                // Gap too wide to be worth sending: close the current span
+                commitSpan(start, y, end - start + 1);
+                start = x;
+            }
+            end = x;
+        }
+        if (start >= 0) commitSpan(start, y, end - start + 1);
+    }
+    resendAll = FALSE;
+
+    if (doubleBuffer) {
+        // The hidden page now holds a complete frame, show it next vblank
+        flipPending = TRUE;
+    }
+}
+
+void TMAP_invalidate(void) {
+    resendAll = TRUE;
+    if (doubleBuffer) {
+        // The page on screen gets redrawn in full on its next turn too
+        memset(front[drawPage ^ 1], 0xFF, sizeof(front[0]));
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * Shadow tilemap - shared by all Genesis games
+ *
+ * Games draw each frame into a RAM copy of plane A and TMAP_flush()
+ * pushes only the cells that differ from what VRAM already holds.
+ * Changed cells are merged into row spans and sent as queued DMA
+ * transfers, which SGDK runs inside the vblank handler.
+ *
+ * With TMAP_DOUBLE_BUFFER the frame is built in a hidden second
+ * nametable (see vram.h) and plane A is repointed at it during vblank,
+ * so the beam never scans a half-updated map.
+ */
+
+#ifndef _COMMON_TILEMAP_H_
+#define _COMMON_TILEMAP_H_
+
+#include <genesis.h>
+
+// Visible area in H40 / V28 mode
+#define TMAP_W      40
+#define TMAP_H      28
+
+// TMAP_init() flags
+#define TMAP_DOUBLE_BUFFER  0x0001
+
+void TMAP_init(VDPPlane plane, u16 flags);
+
+// Start a new frame: empties the back buffer (VRAM is untouched)
+void TMAP_clear(void);
+
+// Cells outside the visible area are ignored
+void TMAP_setTile(u16 attr, s16 x, s16 y);
+void TMAP_drawText(const char* str, s16 x, s16 y);
+// Like VDP_drawTextEx: 'basetile' gives palette / priority / flip bits
+void TMAP_drawTextEx(const char* str, u16 basetile, s16 x, s16 y);
+
+// Queue changed row spans, call once per frame before SYS_doVBlankProcess()
+void TMAP_flush(void);
+
+// Forget what VRAM holds (after something else wrote the plane)
+void TMAP_invalidate(void);
+
+#endif // _COMMON_TILEMAP_H_
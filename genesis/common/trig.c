@@ -0,0 +1,121 @@
+/**
+ * Trig tables - shared by all Genesis games
+ */
+
+#include "trig.h"
+
+// sin(2 * PI * i / 256) in 2.14 fixed point
+static const s16 sine[256] = {
+         0,    402,    804,   1205,   1606,   2006,   2404,   2801,
+      3196,   3590,   3981,   4370,   4756,   5139,   5520,   5897,
+      6270,   6639,   7005,   7366,   7723,   8076,   8423,   8765,
+      9102,   9434,   9760,  10080,  10394,  10702,  11003,  11297,
+     11585,  11866,  12140,  12406,  12665,  12916,  13160,  13395,
+     13623,  13842,  14053,  14256,  14449,  14635,  14811,  14978,
+     15137,  15286,  15426,  15557,  15679,  15791,  15893,  15986,
+     16069,  16143,  16207,  16261,  16305,  16340,  16364,  16379,
+     16384,  16379,  16364,  16340,  16305,  16261,  16207,  16143,
+     16069,  15986,  15893,  15791,  15679,  15557,  15426,  15286,
+     15137,  14978,  14811,  14635,  14449,  14256,  14053,  13842,
+     13623,  13395,  13160,  12916,  12665,  12406,  12140,  11866,
+     11585,  11297,  11003,  10702,  10394,  10080,   9760,   9434,
+      9102,   8765,   8423,   8076,   7723,   7366,   7005,   6639,
+      6270,   5897,   5520,   5139,   4756,   4370,   3981,   3590,
+      3196,   2801,   2404,   2006,   1606,   1205,    804,    402,
+         0,   -402,   -804,  -1205,  -1606,  -2006,  -2404,  -2801,
+     -3196,  -3590,  -3981,  -4370,  -4756,  -5139,  -5520,  -5897,
+     -6270,  -6639,  -7005,  -7366,  -7723,  -8076,  -8423,  -8765,
+     -9102,  -9434,  -9760, -10080, -10394, -10702, -11003, -11297,
+    -11585, -11866, -12140, -12406, -12665, -12916, -13160, -13395,
+    -13623, -13842, -14053, -14256, -14449, -14635, -14811, -14978,
+    -15137, -15286, -15426, -15557, -15679, -15791, -15893, -15986,
+    -16069, -16143, -16207, -16261, -16305, -16340, -16364, -16379,
+    -16384, -16379, -16364, -16340, -16305, -16261, -16207, -16143,
+    -16069, -15986, -15893, -15791, -15679, -15557, -15426, -15286,
+    -15137, -14978, -14811, -14635, -14449, -14256, -14053, -13842,
+    -13623, -13395, -13160, -12916, -12665, -12406, -12140, -11866,
+    -11585, -11297, -11003, -10702, -10394, -10080,  -9760,  -9434,
+     -9102,  -8765,  -8423,  -8076,  -7723,  -7366,  -7005,  -6639,
+     -6270,  -5897,  -5520,  -5139,  -4756,  -4370,  -3981,  -3590,
+     -3196,  -2801,  -2404,  -2006,  -1606,  -1205,   -804,   -402
+};
+
+// atan(min / max) in angle steps (0..32 covers one octant), as
+// atanOctant[max][min] for 0 <= min <= max < 32
+static const u8 atanOctant[32][32] = {
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0, 19, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0, 13, 24, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0, 10, 19, 26, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  8, 16, 22, 27, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  7, 13, 19, 24, 28, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  6, 11, 16, 21, 25, 29, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  5, 10, 15, 19, 23, 26, 29, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  5,  9, 13, 17, 21, 24, 27, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  4,  8, 12, 16, 19, 22, 25, 27, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  4,  7, 11, 14, 17, 20, 23, 26, 28, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  3,  7, 10, 13, 16, 19, 22, 24, 26, 28, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  3,  6,  9, 12, 15, 18, 20, 22, 25, 27, 29, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  3,  6,  9, 11, 14, 16, 19, 21, 23, 25, 27, 29, 30, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  3,  5,  8, 11, 13, 16, 18, 20, 22, 24, 26, 27, 29, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  3,  5,  8, 10, 12, 15, 17, 19, 21, 23, 25, 26, 28, 29, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  5,  7,  9, 12, 14, 16, 18, 20, 22, 23, 25, 27, 28, 29, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  5,  7,  9, 11, 13, 15, 17, 19, 21, 22, 24, 25, 27, 28, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 21, 23, 24, 26, 27, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  4,  6,  8, 10, 12, 14, 16, 17, 19, 20, 22, 23, 25, 26, 27, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  4,  6,  8, 10, 11, 13, 15, 16, 18, 20, 21, 23, 24, 25, 27, 28, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  4,  6,  7,  9, 11, 13, 14, 16, 17, 19, 20, 22, 23, 24, 26, 27, 28, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  4,  5,  7,  9, 10, 12, 14, 15, 17, 18, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  3,  5,  7,  8, 10, 12, 13, 15, 16, 18, 19, 20, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  3,  5,  6,  8, 10, 11, 13, 14, 16, 17, 18, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,  0,  0,  0,  0,  0,  0 },
+    {  0,  2,  3,  5,  6,  8,  9, 11, 12, 14, 15, 16, 18, 19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 30, 31, 32,  0,  0,  0,  0,  0 },
+    {  0,  2,  3,  5,  6,  7,  9, 10, 12, 13, 14, 16, 17, 18, 19, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 30, 31, 32,  0,  0,  0,  0 },
+    {  0,  1,  3,  4,  6,  7,  9, 10, 11, 13, 14, 15, 16, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 30, 31, 32,  0,  0,  0 },
+    {  0,  1,  3,  4,  6,  7,  8, 10, 11, 12, 14, 15, 16, 17, 18, 19, 21, 22, 23, 24, 25, 26, 26, 27, 28, 29, 30, 31, 31, 32,  0,  0 },
+    {  0,  1,  3,  4,  5,  7,  8,  9, 11, 12, 13, 14, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 27, 28, 29, 30, 31, 31, 32,  0 },
+    {  0,  1,  3,  4,  5,  7,  8,  9, 10, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 28, 29, 30, 31, 31, 32 }
+};
+
+s16 TRIG_sin(u8 angle) {
+    return sine[angle];
+}
+
+s16 TRIG_cos(u8 angle) {
+    return sine[(u8)(angle + 64)];
+}
+
+fix16 TRIG_sinScale(u8 angle, fix16 length) {
+    return (fix16)(((s32)length * sine[angle]) >> 14);
+}
+
+fix16 TRIG_cosScale(u8 angle, fix16 length) {
+    return (fix16)(((s32)length * sine[(u8)(angle + 64)]) >> 14);
+}
+
+void TRIG_polar(u8 angle, fix16 speed, fix16* vx, fix16* vy) {
+    *vx = TRIG_cosScale(angle, speed);
+    *vy = TRIG_sinScale(angle, speed);
+}
+
+u8 TRIG_atan2(s16 dy, s16 dx) {
+    if (!dx && !dy) return 0;
+
+    u16 ax = (dx < 0) ? -dx : dx;
+    u16 ay = (dy < 0) ? -dy : dy;
+    u16 big = (ax >= ay) ? ax : ay;
+    u16 small = (ax >= ay) ? ay : ax;
+
+    // Halving both keeps the ratio, so shift until the table covers it
+    while (big >= 32) {
+        big >>= 1;
+        small >>= 1;
+    }
+    u8 angle = atanOctant[big][small];
+    if (ay > ax) angle = 64 - angle;
+
+    // Unfold the quadrant
+    if (dx < 0) angle = 128 - angle;
+    if (dy < 0) angle = -angle;
+    return angle;
+}
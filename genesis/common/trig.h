@@ -0,0 +1,37 @@
+/**
+ * Trig tables - shared by all Genesis games
+ *
+ * Angles are a u8: 256 steps per turn, 0 points right and 64 points down
+ * (screen y grows downwards), so they wrap for free. Sine and cosine
+ * come from one ROM table in 2.14 fixed point; TRIG_atan2 folds the
+ * vector into one octant and reads a small ROM table, so aiming needs no
+ * runtime trig or division.
+ */
+
+#ifndef _COMMON_TRIG_H_
+#define _COMMON_TRIG_H_
+
+#include <genesis.h>
+
+// Handy angles
+#define TRIG_RIGHT      0
+#define TRIG_DOWN       64
+#define TRIG_LEFT       128
+#define TRIG_UP         192
+
+// 1.0 in TRIG_sin / TRIG_cos results
+#define TRIG_ONE        (1 << 14)
+
+s16 TRIG_sin(u8 angle);
+s16 TRIG_cos(u8 angle);
+
+// 'length' times the sine / cosine of 'angle'
+fix16 TRIG_sinScale(u8 angle, fix16 length);
+fix16 TRIG_cosScale(u8 angle, fix16 length);
+// Velocity of 'speed' pointing at 'angle'
+void TRIG_polar(u8 angle, fix16 speed, fix16* vx, fix16* vy);
+
+// Angle of the vector (dx, dy), within 2/256 of a turn
+u8 TRIG_atan2(s16 dy, s16 dx);
+
+#endif // _COMMON_TRIG_H_
@@ -0,0 +1,40 @@
+/**
+ * VBlank tasks - shared by all Genesis games
+ */
+
+#include "vblank.h"
+
+static VoidCallback* tasks[VBL_MAX_TASKS];
+static u8 numTasks = 0;
+static bool installed = FALSE;
+
+static void runTasks(void) {
+    for (u8 i = 0; i < numTasks; i++) tasks[i]();
+}
+
+void VBL_addTask(VoidCallback* task) {
+    if (!installed) {
+        SYS_setVBlankCallback(runTasks);
+        installed = TRUE;
+    }
+
+    for (u8 i = 0; i < numTasks; i++) {
+        if (tasks[i] == task) return;
+    }
+    if (numTasks >= VBL_MAX_TASKS) {
+        SYS_die("VBL_addTask: too many tasks");
+        return;
+    }
+    tasks[numTasks++] = task;
+}
+
+void VBL_removeTask(VoidCallback* task) {
+    for (u8 i = 0; i < numTasks; i++) {
+        if (tasks[i] == task) {
+            // Keep the run order of the remaining tasks
+            for (u8 j = i + 1; j < numTasks; j++) tasks[j - 1] = tasks[j];
+            numTasks--;
+            return;
+        }
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * VBlank tasks - shared by all Genesis games
+ *
+ * SGDK has a single vblank callback; this lets each engine module hook
+ * its own work into it. Tasks run from SYS_doVBlankProcess(), after
+ * SGDK has flushed the DMA queue, in the order they were added.
+ */
+
+#ifndef _COMMON_VBLANK_H_
+#define _COMMON_VBLANK_H_
+
+#include <genesis.h>
+
+#define VBL_MAX_TASKS   8
+
+// Adding the same task twice is a no-op
+void VBL_addTask(VoidCallback* task);
+void VBL_removeTask(VoidCallback* task);
+
+#endif // _COMMON_VBLANK_H_
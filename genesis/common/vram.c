@@ -0,0 +1,88 @@
+/**
+ * VRAM tile allocator - shared by all Genesis games
+ */
+
+#include "vram.h"
+
+// The user area ends where SGDK's font starts
+#define VRAM_FIRST  TILE_USER_INDEX
+#define VRAM_END    TILE_FONT_INDEX
+
+typedef struct {
+    u16 start;
+    u16 size;
+} Block;
+
+// Ranges in use, sorted by start tile; the gaps are the free space
+static Block blocks[VRAM_MAX_BLOCKS];
+static u16 numBlocks;
+
+static bool inPage2(u16 addr, u16 size) {
+    return addr < VRAM_PAGE2_ADDR + VRAM_PAGE2_SIZE && addr + size > VRAM_PAGE2_ADDR;
+}
+
+// Page 2 is only safe while SGDK keeps it inside the user tile area and
+// puts none of its own planes or tables there
+static void checkLayout(void) {
+    u16 planeSize = VDP_getPlaneWidth() * VDP_getPlaneHeight() * 2;
+    if (VRAM_PAGE2_TILE < VRAM_FIRST || VRAM_PAGE2_TILE + VRAM_PAGE2_TILES > VRAM_END ||
+        inPage2(VDP_getPlaneAddress(BG_A, 0, 0), planeSize) ||
+        inPage2(VDP_getPlaneAddress(BG_B, 0, 0), planeSize) ||
+        inPage2(VDP_getPlaneAddress(WINDOW, 0, 0), VRAM_PAGE2_SIZE) ||
+        inPage2(VDP_SPRITE_TABLE, 80 * 8) ||
+        inPage2(VDP_HSCROLL_TABLE, 224 * 4)) {
+        SYS_die("VRAM: page 2 overlaps the SGDK layout");
+    }
+}
+
+void VRAM_init(void) {
+    checkLayout();
+
+    // Page 2 is in the middle of the user area, fence it off for good
+    blocks[0].start = VRAM_PAGE2_TILE;
+    blocks[0].size = VRAM_PAGE2_TILES;
+    numBlocks = 1;
+}
+
+static Block* addBlock(u16 numTiles) {
+    if (numBlocks >= VRAM_MAX_BLOCKS) {
+        SYS_die("VRAM: too many ranges");
+        return NULL;
+    }
+
+    // First fit: the gap before block i (or after the last one)
+    u16 start = VRAM_FIRST;
+    u16 i = 0;
+    for (; i < numBlocks; i++) {
+        if (blocks[i].start - start >= numTiles) break;
+        start = blocks[i].start + blocks[i].size;
+    }
+    if (i == numBlocks && VRAM_END - start < numTiles) {
+        SYS_die("VRAM: out of tiles");
+        return NULL;
+    }
+
+    memmove(&blocks[i + 1], &blocks[i], (numBlocks - i) * sizeof(Block));
+    numBlocks++;
+    blocks[i].start = start;
+    blocks[i].size = numTiles;
+    return &blocks[i];
+}
+
+u16 VRAM_alloc(u16 numTiles) {
+    Block* b = addBlock(numTiles);
+    return b ? b->start : 0;
+}
+
+u16 VRAM_loadTileSet(const TileSet* tileset) {
+    Block* b = addBlock(tileset->numTile);
+    if (!b) return 0;
+    VDP_loadTileSet(tileset, b->start, DMA);
+    return b->start;
+}
+
+u16 VRAM_getFree(void) {
+    u16 used = 0;
+    for (u16 i = 0; i < numBlocks; i++) used += blocks[i].size;
+    return (VRAM_END - VRAM_FIRST) - used;
+}
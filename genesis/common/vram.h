@@ -0,0 +1,50 @@
+/**
+ * VRAM layout and tile allocator - shared by all Genesis games
+ *
+ * SGDK's default layout plus a second plane A nametable used by the
+ * double-buffered tilemap. Plane A bases must sit on a 0x2000 boundary,
+ * so the second page takes a block of the user tile area instead.
+ *
+ *   0x0000 - 0x1FFF   tiles 0-255 (system tiles, then game tiles)
+ *   0x2000 - 0x2FFF   plane A page 2 (64x32 cells), tiles 256-383 reserved
+ *   0x3000 - ...      tiles 384+ up to SGDK's font / sprite / plane area
+ *
+ * The allocator hands out ranges of the user tile area (TILE_USER_INDEX
+ * up to the font, around page 2) at runtime instead of fixed tile
+ * numbers, so a game never has to lay out tile indexes by hand. Every
+ * game's art is used on the title and in play alike, so ranges are
+ * taken once at boot and kept; animation frames stream from ROM into
+ * their slot (common/tileanim) and take no range of their own.
+ *
+ * Games keep tile numbers as offsets from the returned base, e.g.
+ * #define TILE_BALL (gameTiles + 2).
+ */
+
+#ifndef _COMMON_VRAM_H_
+#define _COMMON_VRAM_H_
+
+#include <genesis.h>
+
+#define VRAM_PAGE2_ADDR         0x2000
+#define VRAM_PAGE2_SIZE         (64 * 32 * 2)
+
+// Tile slots overlapped by page 2, never hand these out
+#define VRAM_PAGE2_TILE         (VRAM_PAGE2_ADDR / 32)
+#define VRAM_PAGE2_TILES        (VRAM_PAGE2_SIZE / 32)
+
+// Ranges in use at the same time
+#define VRAM_MAX_BLOCKS         32
+
+// Free the whole user tile area (except page 2); stops with SYS_die()
+// if SGDK's font, planes or tables would land on page 2
+void VRAM_init(void);
+
+// Reserve 'numTiles' tiles, returns the first tile index
+u16 VRAM_alloc(u16 numTiles);
+// Reserve a range for a tileset and load it, returns its first tile index
+u16 VRAM_loadTileSet(const TileSet* tileset);
+
+// Tiles not in any range
+u16 VRAM_getFree(void);
+
+#endif // _COMMON_VRAM_H_
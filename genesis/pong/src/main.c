@@ -4,397 +4,429 @@
  */
 
 #include <genesis.h>
+#include "resources.h"
 
-#define TILE_EMPTY      0
-#define TILE_PADDLE     1
-#define TILE_BALL       2
-#define TILE_BORDER     3
-#define TILE_SPARK      4
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/kinematics.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/particles.h"
+#include "common/rng.h"
+#include "common/sched.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/sprites.h"
+#include "common/tileanim.h"
+#include "common/tilemap.h"
+#include "common/trig.h"
+#include "common/vram.h"
+
+#define TILE_EMPTY      (gameTiles + 0)
+#define TILE_PADDLE     (gameTiles + 1)
+#define TILE_BALL       (gameTiles + 2)
+#define TILE_BORDER     (gameTiles + 3)
+#define TILE_SPARK      (gameTiles + 4)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
 
 #define ARENA_W         40
 #define ARENA_H         26
 #define PADDLE_H        5
+#define PADDLE_PX       (PADDLE_H * 8)
+
+// Pixel bounds: walls are the top and bottom rows, paddle faces at
+// columns 2 and ARENA_W - 2
+#define WALL_TOP        8
+#define WALL_BOTTOM     ((ARENA_H - 2) * 8)
+#define PADDLE1_FACE    16
+#define PADDLE2_FACE    ((ARENA_W - 2) * 8)
+
+// Pixels per frame
+#define PADDLE_SPEED    FIX16(4)
+#define AI_SPEED        FIX16(2)
 #define WIN_SCORE       11
 
-static s16 paddle1Y, paddle2Y;
-static s16 ballX, ballY;
-static s8 ballDX, ballDY;
+#define PLAYFIELD_NONE  0xFF
+
+// CRAM entries the paddle tiles are drawn with
+#define PADDLE1_COLOR   33
+#define PADDLE2_COLOR   49
+
+// HUD counters (bottom two rows, below the arena)
+#define HUD_SCORE1      0
+#define HUD_SCORE2      1
+#define HUD_RALLY       2
+
+static KinBody paddle1, paddle2;
+static KinBody ball;
 static u8 score1, score2;
 static u8 gameState;
 static u8 gameMode;
 static u16 frameCount;
-static u16 seed = 12345;
 
 // PIZZAZZ variables
-static s16 shakeX = 0, shakeY = 0;
-static u8 shakeTimer = 0;
 static u8 soundEnabled = 1;
-static u8 ballSpeed = 1;
+static u8 ballSpeed = 0;     // index into ballSpeeds
 static u8 rallyCount = 0;
 static u16 highScore1 = 0, highScore2 = 0;
-static u8 titleFrame = 0;
-static u8 flashPaddle = 0;  // 1 or 2 for which paddle flashes
-static u8 flashTimer = 0;
-static u8 sparkX, sparkY, sparkTimer = 0;
+// Title ball cell and frames until it next steps across / down
+static u8 titleBallX = 0, titleBallY = 0;
+static u8 titleTimerX = 0, titleTimerY = 0;
+static u16 sparkAnim;
 static u8 comboMultiplier = 1;
+static u8 playfieldPal = PLAYFIELD_NONE;  // border palette currently on BG_B
+static char finalScore[24];  // formatted once when the match ends
 
-static u16 rnd() {
-    seed = seed * 1103515245 + 12345;
-    return (seed >> 16) & 0x7FFF;
-}
+// Ball speed as the rally grows
+static const fix16 ballSpeeds[3] = { FIX16(2.75), FIX16(4), FIX16(5.5) };
 
 // ============ SOUND EFFECTS ============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+static const SfxStep bounceSteps[] = { { 600, 14, 5, 0, 1 }, SFX_END };
+static const SfxStep scoreSteps[] = { { 200, 15, 12, -5, 1 }, SFX_END };
+static const SfxStep wallSteps[] = { { 300, 9, 3, 0, 1 }, SFX_END };
+static const SfxStep victorySteps[] = {
+    { 500, 15, 6, 0, 0 }, { 650, 15, 6, 0, 0 }, { 800, 15, 6, 0, 0 }, { 950, 15, 6, 0, 0 },
+    { 1200, 15, 30, 0, 2 }, SFX_END
+};
+static const SfxStep blipSteps[] = { { 1000, 12, 3, 0, 1 }, SFX_END };
+
+static const Sfx sfxBounce = { SFX_PRIO_MID, FALSE, bounceSteps };
+static const Sfx sfxScore = { SFX_PRIO_HIGH, FALSE, scoreSteps };
+static const Sfx sfxWall = { SFX_PRIO_LOW, FALSE, wallSteps };
+static const Sfx sfxVictory = { SFX_PRIO_JINGLE, FALSE, victorySteps };
+static const Sfx sfxBlip = { SFX_PRIO_LOW, FALSE, blipSteps };
+
 static void playBounce(u8 intensity) {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 600 + intensity * 100);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 6);
+    SFX_playPitch(&sfxBounce, intensity * 100);
 }
 
 static void playScore() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 200);
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 10);
-    // Noise
-    PSG_setEnvelope(3, PSG_ENVELOPE_MAX);
-    PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_TONE3);
+    SFX_play(&sfxScore);
+    AUD_PLAY_PCM(impact_pcm, SFX_PRIO_HIGH);
 }
 
 static void playWallBounce() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(2, PSG_ENVELOPE_MAX - 6);
-    PSG_setFrequency(2, 300);
-    PSG_setEnvelope(2, PSG_ENVELOPE_MIN + 3);
+    SFX_play(&sfxWall);
 }
 
 static void playVictory() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 500 + i * 150);
-        for (u16 j = 0; j < 4000; j++) {}
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1200);
+    SFX_play(&sfxVictory);
 }
 
 static void playMenuBlip() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1000);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 2);
+    SFX_play(&sfxBlip);
 }
 
-static void updateSound() {
-    static u8 fadeTimer = 0;
-    fadeTimer++;
-    if (fadeTimer > 4) {
-        fadeTimer = 0;
-        for (u8 ch = 0; ch < 4; ch++) {
-            PSG_setEnvelope(ch, PSG_ENVELOPE_MIN);
-        }
-    }
+// Background track, on the Z80 for the whole game
+static void playMusic() {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============ SCREEN SHAKE ============
 static void startShake(u8 intensity) {
-    shakeTimer = intensity;
+    SCRL_shake(SCRL_LAYERS, intensity, intensity);
 }
 
-static void updateShake() {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeY = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeTimer--;
-    } else {
-        shakeX = shakeY = 0;
+// ============ STATIC PLAYFIELD (BG_B) ============
+// Border and centre line only change with the rally colour, so they
+// live on BG_B and get redrawn on change instead of every frame
+static void drawPlayfield(u8 borderPal) {
+    u16 border = TILE_ATTR_FULL(borderPal, 0, 0, 0, TILE_BORDER);
+    // First draw after a text screen: drop the text
+    if (playfieldPal == PLAYFIELD_NONE) VDP_clearPlane(BG_B, TRUE);
+    VDP_fillTileMapRect(BG_B, border, 0, 0, ARENA_W, 1);
+    VDP_fillTileMapRect(BG_B, border, 0, ARENA_H-1, ARENA_W, 1);
+    
+    // Center line (dashed) keeps its colour
+    if (playfieldPal == PLAYFIELD_NONE) {
+        for (u8 y = 1; y < ARENA_H - 1; y += 2) {
+            VDP_setTileMapXY(BG_B, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BORDER), ARENA_W/2, y);
+        }
     }
-    VDP_setHorizontalScroll(BG_A, shakeX);
-    VDP_setVerticalScroll(BG_A, shakeY);
+    playfieldPal = borderPal;
 }
 
-static void createTiles() {
-    u32 tileData[8];
-    
-    memset(tileData, 0, 32);
-    VDP_loadTileData(tileData, TILE_EMPTY, 1, CPU);
+// ============ SCREENS ============
+// Static text, sent to BG_B once on entering the state
+static const ScreenText titleScreen[] = {
+    // Standard title block
+    { 10,  4, "====================" },
+    { 10,  5, "       PONG         " },
+    { 10,  6, "====================" },
+    { 12,  8, "Free Retro Games" },
+    { 17,  9, "v1.0.0" },
     
-    memset(tileData, 0x11, 32);
-    VDP_loadTileData(tileData, TILE_PADDLE, 1, CPU);
+    // Player select
+    { 10, 13, "--------------------" },
+    { 12, 15, "START - 1 Player" },
+    { 12, 17, "    A - 2 Players" },
+    { 10, 19, "--------------------" },
     
-    memset(tileData, 0x22, 32);
-    VDP_loadTileData(tileData, TILE_BALL, 1, CPU);
+    { 11, 21, "First to 11 wins!" },
+    { 16, 23, "C: Sound" },
     
-    memset(tileData, 0x33, 32);
-    VDP_loadTileData(tileData, TILE_BORDER, 1, CPU);
+    // Footer
+    { 11, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+static const ScreenText gameOverScreen[] = {
+    { 10, 14, finalScore },
+    {  7, 20, "Press START to play again" },
+    SCRN_END
+};
+
+// Title and game over text replace the playfield on BG_B
+static void loadScreen(const ScreenText* layout) {
+    SCRN_load(BG_B, layout);
+    playfieldPal = PLAYFIELD_NONE;
+}
+
+static void createTiles() {
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
     
-    // Spark/hit effect
-    memset(tileData, 0, 32);
-    tileData[1] = 0x00200200;
-    tileData[2] = 0x02020020;
-    tileData[3] = 0x00222200;
-    tileData[4] = 0x00222200;
-    tileData[5] = 0x02020020;
-    tileData[6] = 0x00200200;
-    VDP_loadTileData(tileData, TILE_SPARK, 1, CPU);
+    // Spark/hit effect (one-shot, replayed on every hit)
+    sparkAnim = TANIM_add(TILE_SPARK, spark_anim.tiles, spark_anim.numTile, 3, FALSE);
 }
 
-static void spawnSpark(u8 x, u8 y) {
-    sparkX = x;
-    sparkY = y;
-    sparkTimer = 8;
+static void spawnSpark(s16 x, s16 y) {
+    PART_spawn(x, y, 0, 0, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_SPARK), 8, 0);
+    TANIM_play(sparkAnim);
 }
 
 static void resetBall() {
-    ballX = ARENA_W / 2;
-    ballY = ARENA_H / 2;
-    ballDX = (rnd() % 2) ? 1 : -1;
-    ballDY = (rnd() % 2) ? 1 : -1;
-    ballSpeed = 1;
+    ballSpeed = 0;
+    KIN_set(&ball, ARENA_W * 4, ARENA_H * 4, 0, 0);
+    // One of the four diagonals
+    TRIG_polar(TRIG_DOWN / 2 + RNG_range(RNG_GAME, 4) * TRIG_DOWN, ballSpeeds[0], &ball.vx, &ball.vy);
     rallyCount = 0;
     comboMultiplier = 1;
 }
 
 static void initGame(u8 mode) {
+    // Serves depend only on this seed, so a match can be replayed
+    RNG_init(frameCount);
     gameMode = mode;
     score1 = score2 = 0;
-    paddle1Y = paddle2Y = ARENA_H / 2 - PADDLE_H / 2;
+    KIN_set(&paddle1, 8, ARENA_H * 4 - PADDLE_PX / 2, 0, 0);
+    KIN_set(&paddle2, PADDLE2_FACE, ARENA_H * 4 - PADDLE_PX / 2, 0, 0);
     resetBall();
+    PART_clear();
+    PFX_stop(1);
+    HUD_clear();
+    HUD_show(TRUE);
     gameState = 1;
+    playMusic();
+}
+
+static fix16 joyToSpeed(u16 joy) {
+    if (joy & BUTTON_UP) return -PADDLE_SPEED;
+    if (joy & BUTTON_DOWN) return PADDLE_SPEED;
+    return 0;
 }
 
 static void updatePaddles() {
-    u16 joy1 = JOY_readJoypad(JOY_1);
-    if (joy1 & BUTTON_UP) paddle1Y -= 2;  // Faster paddle
-    if (joy1 & BUTTON_DOWN) paddle1Y += 2;
-    
-    if (paddle1Y < 1) paddle1Y = 1;
-    if (paddle1Y > ARENA_H - PADDLE_H - 1) paddle1Y = ARENA_H - PADDLE_H - 1;
+    paddle1.vy = joyToSpeed(INPUT_held(JOY_1));
+    KIN_step(&paddle1);
+    KIN_clampY(&paddle1, WALL_TOP, WALL_BOTTOM + 8 - PADDLE_PX);
     
     if (gameMode == 1) {
-        u16 joy2 = JOY_readJoypad(JOY_2);
-        if (joy2 & BUTTON_UP) paddle2Y -= 2;
-        if (joy2 & BUTTON_DOWN) paddle2Y += 2;
+        paddle2.vy = joyToSpeed(INPUT_held(JOY_2));
+        KIN_step(&paddle2);
     } else {
         // Smarter AI - tracks ball with some delay
-        s16 targetY = ballY - PADDLE_H/2;
-        if (paddle2Y < targetY) paddle2Y++;
-        if (paddle2Y > targetY) paddle2Y--;
+        fix16 targetY = ball.y + FIX16(4) - intToFix16(PADDLE_PX / 2);
+        paddle2.y = KIN_approach(paddle2.y, targetY, AI_SPEED);
     }
-    
-    if (paddle2Y < 1) paddle2Y = 1;
-    if (paddle2Y > ARENA_H - PADDLE_H - 1) paddle2Y = ARENA_H - PADDLE_H - 1;
+    KIN_clampY(&paddle2, WALL_TOP, WALL_BOTTOM + 8 - PADDLE_PX);
+}
+
+// Send the ball back from a paddle, steeper the further from its centre
+// it hit (up to about 50 degrees at the ends)
+static void returnBall(const KinBody* paddle, s16 dir) {
+    rallyCount++;
+    if (rallyCount > 5) ballSpeed = 1;
+    if (rallyCount > 10) ballSpeed = 2;  // Even faster!
+    
+    s16 hitPos = (KIN_Y(&ball) + 4) - (KIN_Y(paddle) + PADDLE_PX / 2);
+    u8 angle = hitPos + (hitPos >> 1);
+    if (dir < 0) angle = TRIG_LEFT - angle;
+    TRIG_polar(angle, ballSpeeds[ballSpeed], &ball.vx, &ball.vy);
+    
+    playBounce(rallyCount);
+    spawnSpark(KIN_X(&ball), KIN_Y(&ball));
+    startShake(1);
+}
+
+static bool hitsPaddle(const KinBody* paddle) {
+    s16 y = KIN_Y(&ball);
+    s16 top = KIN_Y(paddle);
+    return y + 8 > top && y < top + PADDLE_PX;
 }
 
 static void updateBall() {
-    // Speed ramp based on rally
-    u8 speed = 1;
-    if (rallyCount > 5) speed = 2;
-    if (rallyCount > 10) {
-        speed = 2;
-        if (frameCount % 2 == 0) speed = 3;  // Even faster!
+    s16 lastX = KIN_X(&ball);
+    KIN_step(&ball);
+    s16 x = KIN_X(&ball);
+    
+    // Top/bottom bounce
+    if (ball.y <= intToFix16(WALL_TOP)) {
+        ball.y = intToFix16(WALL_TOP);
+        if (ball.vy < 0) ball.vy = -ball.vy;
+        playWallBounce();
+        spawnSpark(x, WALL_TOP);
+    }
+    if (ball.y >= intToFix16(WALL_BOTTOM)) {
+        ball.y = intToFix16(WALL_BOTTOM);
+        if (ball.vy > 0) ball.vy = -ball.vy;
+        playWallBounce();
+        spawnSpark(x, WALL_BOTTOM);
     }
     
-    for (u8 s = 0; s < speed; s++) {
-        ballX += ballDX;
-        ballY += ballDY;
+    // Paddle 1 hit: the ball's left edge crossed its face this frame
+    if (lastX >= PADDLE1_FACE && x < PADDLE1_FACE && hitsPaddle(&paddle1)) {
+        ball.x = intToFix16(PADDLE1_FACE);
+        returnBall(&paddle1, 1);
+        PFX_flash(PADDLE1_COLOR, RGB24_TO_VDPCOLOR(0xFFFFFF), 6, 1);
         
-        // Top/bottom bounce
-        if (ballY <= 1) {
-            ballDY = 1;
-            playWallBounce();
-            spawnSpark(ballX, ballY);
-        }
-        if (ballY >= ARENA_H - 2) {
-            ballDY = -1;
-            playWallBounce();
-            spawnSpark(ballX, ballY);
-        }
-        
-        // Paddle 1 hit
-        if (ballX == 2 && ballY >= paddle1Y && ballY < paddle1Y + PADDLE_H) {
-            ballDX = 1;
-            rallyCount++;
-            
-            // Angle based on where ball hits paddle
-            s8 hitPos = ballY - paddle1Y - PADDLE_H/2;
-            ballDY = (hitPos > 0) ? 1 : ((hitPos < 0) ? -1 : ballDY);
-            
-            playBounce(rallyCount);
-            spawnSpark(ballX, ballY);
-            flashPaddle = 1;
-            flashTimer = 6;
-            startShake(1);
-            
-            // Easter egg: 20+ rally gets screen shake
-            if (rallyCount == 20) {
-                startShake(4);
-            }
-        }
-        
-        // Paddle 2 hit
-        if (ballX == ARENA_W - 3 && ballY >= paddle2Y && ballY < paddle2Y + PADDLE_H) {
-            ballDX = -1;
-            rallyCount++;
-            
-            s8 hitPos = ballY - paddle2Y - PADDLE_H/2;
-            ballDY = (hitPos > 0) ? 1 : ((hitPos < 0) ? -1 : ballDY);
-            
-            playBounce(rallyCount);
-            spawnSpark(ballX, ballY);
-            flashPaddle = 2;
-            flashTimer = 6;
-            startShake(1);
-        }
-        
-        // Score
-        if (ballX <= 0) {
-            score2++;
-            playScore();
-            startShake(8);
-            resetBall();
-            return;
-        }
-        if (ballX >= ARENA_W - 1) {
-            score1++;
-            playScore();
-            startShake(8);
-            resetBall();
-            return;
+        // Easter egg: 20+ rally gets screen shake
+        if (rallyCount == 20) {
+            startShake(4);
         }
     }
     
+    // Paddle 2 hit: same for the right edge
+    if (lastX + 8 <= PADDLE2_FACE && x + 8 > PADDLE2_FACE && hitsPaddle(&paddle2)) {
+        ball.x = intToFix16(PADDLE2_FACE - 8);
+        returnBall(&paddle2, -1);
+        PFX_flash(PADDLE2_COLOR, RGB24_TO_VDPCOLOR(0xFFFFFF), 6, 1);
+    }
+    
+    // Score
+    if (x <= 0 || x >= (ARENA_W - 1) * 8) {
+        if (x <= 0) score2++;
+        else score1++;
+        playScore();
+        SCRL_ripple(SCRL_LAYERS, x + 4, KIN_Y(&ball) + 4, 6, 30);
+        resetBall();
+    }
+    
     if (score1 >= WIN_SCORE || score2 >= WIN_SCORE) {
         gameState = 2;
+        AUD_stopMusic();
         if (score1 > highScore1) highScore1 = score1;
         if (score2 > highScore2) highScore2 = score2;
+        sprintf(finalScore, "Final Score: %d - %d", score1, score2);
+        loadScreen(gameOverScreen);
+        HUD_show(FALSE);
         playVictory();
     }
 }
 
 static void draw() {
-    VDP_clearPlane(BG_A, TRUE);
+    TMAP_clear();
     
     // Border with varying color based on rally
     u8 borderPal = PAL1;
     if (rallyCount > 10) borderPal = PAL2;
     if (rallyCount > 15) borderPal = PAL3;
+    if (borderPal != playfieldPal) drawPlayfield(borderPal);
     
-    for (u8 x = 0; x < ARENA_W; x++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(borderPal, 0, 0, 0, TILE_BORDER), x, 0);
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(borderPal, 0, 0, 0, TILE_BORDER), x, ARENA_H-1);
-    }
-    
-    // Center line (dashed)
-    for (u8 y = 1; y < ARENA_H - 1; y += 2) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BORDER), ARENA_W/2, y);
-    }
-    
-    // Paddles with flash effect
-    u8 pal1 = (flashPaddle == 1 && flashTimer > 0 && frameCount % 2) ? PAL0 : PAL2;
-    u8 pal2 = (flashPaddle == 2 && flashTimer > 0 && frameCount % 2) ? PAL0 : PAL3;
-    
+    // Paddles (hit flash is done on their palette entries)
     for (u8 i = 0; i < PADDLE_H; i++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal1, 0, 0, 0, TILE_PADDLE), 1, paddle1Y + i);
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal2, 0, 0, 0, TILE_PADDLE), ARENA_W-2, paddle2Y + i);
+        SPRL_add(KIN_X(&paddle1), KIN_Y(&paddle1) + i * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_PADDLE), TRUE);
+        SPRL_add(KIN_X(&paddle2), KIN_Y(&paddle2) + i * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_PADDLE), TRUE);
     }
     
-    // Ball with trail effect
+    // Ball with trail effect (ball first so it stays on top)
+    SPRL_add(KIN_X(&ball), KIN_Y(&ball), SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), TRUE);
     if (rallyCount > 5) {
-        // Ghost ball trail
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BALL), ballX - ballDX, ballY - ballDY);
+        // Ghost ball trail, two frames behind
+        SPRL_add(fix16ToInt(ball.x - ball.vx * 2), fix16ToInt(ball.y - ball.vy * 2), SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BALL), FALSE);
     }
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), ballX, ballY);
     
-    // Spark effect
-    if (sparkTimer > 0) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_SPARK), sparkX, sparkY);
-        sparkTimer--;
-    }
+    // Spark effects
+    PART_draw();
     
-    // Score display - big and centered
-    char buf[8];
-    sprintf(buf, "%d", score1);
-    VDP_drawText(buf, 15, 1);
-    sprintf(buf, "%d", score2);
-    VDP_drawText(buf, 24, 1);
+    // Score display - centered under the court
+    HUD_setCounter(HUD_SCORE1, score1);
+    HUD_setCounter(HUD_SCORE2, score2);
     
     // Rally counter
     if (rallyCount > 3) {
-        sprintf(buf, "RALLY:%d", rallyCount);
-        VDP_drawText(buf, 16, ARENA_H);
+        HUD_drawText("RALLY:", 14, ARENA_H + 1);
+        HUD_setCounter(HUD_RALLY, rallyCount);
         
-        if (rallyCount >= 10) {
-            VDP_drawText("HOT!", 17, ARENA_H + 1);
-        }
         if (rallyCount >= 20) {
-            VDP_drawText("ON FIRE!", 16, ARENA_H + 1);
+            HUD_drawText("ON FIRE!", 24, ARENA_H + 1);
+        } else if (rallyCount >= 10) {
+            HUD_drawText("HOT!    ", 24, ARENA_H + 1);
+        } else {
+            HUD_clearText(24, ARENA_H + 1, 8);
         }
+    } else {
+        HUD_clearText(14, ARENA_H + 1, 6);
+        HUD_hideCounter(HUD_RALLY);
+        HUD_clearText(24, ARENA_H + 1, 8);
     }
     
     // Sound indicator
-    VDP_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H);
+    HUD_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H);
 }
 
+// Static text is in titleScreen, only what moves or toggles is drawn here
 static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    titleFrame++;
+    TMAP_clear();
     
-    // Pulsing title
-    if (titleFrame % 20 < 10) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0x88FFFF));
+    // Bouncing ball animation: across every 3 frames, down every 5
+    if (titleTimerX) titleTimerX--;
+    else {
+        titleTimerX = 2;
+        titleBallX = (titleBallX == 19) ? 0 : titleBallX + 1;
     }
-    
-    // Standard title block
-    VDP_drawText("====================", 10, 4);
-    VDP_drawText("       PONG         ", 10, 5);
-    VDP_drawText("====================", 10, 6);
-    VDP_drawText("Free Retro Games", 12, 8);
-    VDP_drawText("v1.0.0", 17, 9);
-    
-    // Bouncing ball animation
-    u8 animBallX = 10 + (titleFrame / 3) % 20;
-    u8 animBallY = 11 + ((titleFrame / 5) % 3);
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), animBallX, animBallY);
-    
-    // Player select
-    VDP_drawText("--------------------", 10, 13);
-    VDP_drawText("START - 1 Player", 12, 15);
-    VDP_drawText("    A - 2 Players", 12, 17);
-    VDP_drawText("--------------------", 10, 19);
-    
-    VDP_drawText("First to 11 wins!", 11, 21);
+    if (titleTimerY) titleTimerY--;
+    else {
+        titleTimerY = 4;
+        titleBallY = (titleBallY == 2) ? 0 : titleBallY + 1;
+    }
+    TMAP_setTile(TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BALL), 10 + titleBallX, 11 + titleBallY);
     
     // Sound toggle
-    VDP_drawText("C: Sound", 16, 23);
-    VDP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
-    
-    // Footer
-    VDP_drawText("(C) 2026 monteslu", 11, 27);
+    TMAP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
 }
 
 static void drawGameOver() {
-    VDP_clearPlane(BG_A, TRUE);
+    TMAP_clear();
     
     // Flashing winner
-    if (frameCount % 8 < 4) {
+    if (!(frameCount & 4)) {
         if (score1 >= WIN_SCORE) {
-            VDP_drawText("*** PLAYER 1 WINS! ***", 9, 10);
+            TMAP_drawText("*** PLAYER 1 WINS! ***", 9, 10);
         } else {
-            VDP_drawText("*** PLAYER 2 WINS! ***", 9, 10);
+            TMAP_drawText("*** PLAYER 2 WINS! ***", 9, 10);
         }
     }
     
-    char buf[24];
-    sprintf(buf, "Final Score: %d - %d", score1, score2);
-    VDP_drawText(buf, 10, 14);
-    
-    VDP_drawText("Press START to play again", 7, 20);
 }
 
+// Title frame for the cycle benchmark (play has no division): the
+// bouncing ball's two steps
+static const BenchProfile benchProfile = { 4, 2, 0, 0, 0 };
+
 int main() {
     VDP_setScreenWidth320();
     PAL_setColor(0, RGB24_TO_VDPCOLOR(0x000000));
@@ -405,17 +437,37 @@ int main() {
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0x00FF00)); // PAL2: green P1
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0x0088FF)); // PAL3: blue P2
     
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("PONG", &benchProfile);
+    
+    RNG_init(12345);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    TANIM_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    SPRL_init();
+    PART_init(0);   // sparks are tiles only
+    SCHED_init(0);
+    SCHED_addTask(PART_update, 4);
+    TMAP_init(BG_A, 0);
+    HUD_init(TRUE, 2);
+    HUD_setupCounter(HUD_SCORE1, 14, ARENA_H, 2, 0);
+    HUD_setupCounter(HUD_SCORE2, 24, ARENA_H, 2, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_RALLY, 20, ARENA_H + 1, 3, HUD_ALIGN_LEFT);
     gameState = 0;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0x88FFFF), 20);  // Pulsing title
+    loadScreen(titleScreen);
     drawTitle();
     
-    u16 lastJoy = 0;
-    
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy;
-        seed += frameCount;
+        SCHED_beginFrame();
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
         
         if (gameState == 0) {
             if (pressed & BUTTON_START) {
@@ -430,28 +482,33 @@ int main() {
                 soundEnabled = !soundEnabled;
                 playMenuBlip();
             }
-            drawTitle();
+            // A new state has drawn its own screen already
+            if (gameState == 0) drawTitle();
         } else if (gameState == 1) {
-            if (frameCount % 4 == 0) {
+            while (ticks-- && gameState == 1) {
                 updatePaddles();
                 updateBall();
             }
+            SCHED_runOptional();
             
-            if (flashTimer > 0) flashTimer--;
-            updateShake();
-            updateSound();
-            draw();
+            // The game-over screen is queued, leave BG_B and sprites to it
+            if (gameState == 1) draw();
         } else {
             drawGameOver();
             if (pressed & BUTTON_START) {
                 playMenuBlip();
                 gameState = 0;
+                PFX_pulse(1, RGB24_TO_VDPCOLOR(0x88FFFF), 20);
+                loadScreen(titleScreen);
                 drawTitle();
             }
         }
         
         frameCount++;
+        TMAP_flush();
+        SPRL_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     return 0;
 }
@@ -3,14 +3,33 @@
  */
 
 #include <genesis.h>
+#include "resources.h"
 
-#define TILE_EMPTY   0
-#define TILE_SNAKE1  1
-#define TILE_SNAKE2  2
-#define TILE_FOOD    3
-#define TILE_WALL    4
-#define TILE_HEAD1   5
-#define TILE_HEAD2   6
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/rng.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/tileanim.h"
+#include "common/tilemap.h"
+#include "common/vram.h"
+
+#define TILE_EMPTY   (gameTiles + 0)
+#define TILE_SNAKE1  (gameTiles + 1)
+#define TILE_SNAKE2  (gameTiles + 2)
+#define TILE_FOOD    (gameTiles + 3)
+#define TILE_WALL    (gameTiles + 4)
+#define TILE_HEAD1   (gameTiles + 5)
+#define TILE_HEAD2   (gameTiles + 6)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
 
 #define ARENA_W      38
 #define ARENA_H      24
@@ -18,6 +37,12 @@
 #define OFFSET_X     1
 #define OFFSET_Y     3
 
+// HUD counters (top three rows, above the arena)
+#define HUD_SCORE    0
+#define HUD_LEN      1
+#define HUD_HI       2
+#define HUD_COMBO    3
+
 static s8 snake1X[MAX_LEN], snake1Y[MAX_LEN];
 static s8 snake2X[MAX_LEN], snake2Y[MAX_LEN];
 static u8 len1, len2, dir1, dir2, ndir1, ndir2;
@@ -26,162 +51,87 @@ static u8 alive1, alive2;
 static u16 score;
 static u8 gameState, gameMode;
 static u16 frameCount;
-static u16 seed = 54321;
 static u8 speed = 8;
+static u8 moveTimer;            // frames until the snakes move
 static u8 combo = 0;
 static u8 comboTimer = 0;
-static s8 shakeX, shakeY;
-static u8 shakeTimer;
 static u8 soundEnabled = TRUE;
-static u8 titleAnim;
-static u8 foodAnim;
+static u8 titleTimer;           // frames until the title snake bobs
+static u8 titleBob;
 static u16 highScore = 0;
-
-// Forward declaration
-static u16 rnd(void);
+// Formatted once per state change rather than every frame
+static char hiScoreText[24];
+static char scoreText[20];
 
 // ============= SOUND =============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+
+static const SfxStep eatSteps[] = { { 800, 15, 8, 0, 1 }, SFX_END };
+static const SfxStep deathSteps[] = {
+    { 400, 15, 5, 0, 0 }, { 320, 14, 5, 0, 0 }, { 240, 13, 5, 0, 0 }, { 160, 12, 5, 0, 1 }, SFX_END
+};
+static const SfxStep comboSteps[] = { { 523, 15, 3, 0, 0 }, { 659, 15, 3, 0, 0 }, { 784, 15, 3, 0, 0 }, SFX_END };
+
+static const Sfx sfxEatFx = { SFX_PRIO_MID, FALSE, eatSteps };
+static const Sfx sfxDeathFx = { SFX_PRIO_JINGLE, FALSE, deathSteps };
+static const Sfx sfxComboFx = { SFX_PRIO_HIGH, FALSE, comboSteps };
 
 static void sfxEat(void) {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 800 + combo * 100);
+    SFX_playPitch(&sfxEatFx, combo * 100);
 }
 
 static void sfxDeath(void) {
     if (!soundEnabled) return;
-    // Descending death sound
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX - i);
-        PSG_setFrequency(0, 400 - i * 80);
-        for (u8 j = 0; j < 5; j++) SYS_doVBlankProcess();
-    }
-    // Noise crash
-    PSG_setEnvelope(3, PSG_ENVELOPE_MAX);
-    PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_CLOCK4);
+    // Crash, then a descending death sound
+    AUD_PLAY_PCM(impact_pcm, SFX_PRIO_JINGLE);
+    SFX_play(&sfxDeathFx);
 }
 
 static void sfxCombo(void) {
     if (!soundEnabled) return;
     // Quick ascending arpeggio
-    u16 notes[] = {523, 659, 784};
-    for (u8 i = 0; i < 3; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, notes[i]);
-        for (u8 j = 0; j < 3; j++) SYS_doVBlankProcess();
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
+    SFX_play(&sfxComboFx);
 }
 
-static void sfxSilence(void) {
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN);
-    PSG_setEnvelope(3, PSG_ENVELOPE_MIN);
+// Background track, on the Z80 for the whole game
+static void playMusic(void) {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============= EFFECTS =============
 
 static void startShake(u8 intensity) {
-    shakeTimer = intensity;
+    SCRL_shake(SCRL_LAYERS, 4, intensity);
 }
 
-static void updateShake(void) {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % 9) - 4;
-        shakeY = (rnd() % 9) - 4;
-        shakeTimer--;
-        VDP_setHorizontalScroll(BG_A, shakeX);
-        VDP_setVerticalScroll(BG_A, shakeY);
-    } else if (shakeX || shakeY) {
-        shakeX = shakeY = 0;
-        VDP_setHorizontalScroll(BG_A, 0);
-        VDP_setVerticalScroll(BG_A, 0);
-    }
+// Border never changes during a game, so it lives on BG_B and is
+// drawn once per game instead of every frame
+static void drawWalls(void) {
+    u16 wall = TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL);
+    VDP_clearPlane(BG_B, TRUE);  // drop the title text
+    VDP_fillTileMapRect(BG_B, wall, OFFSET_X, OFFSET_Y, ARENA_W, 1);
+    VDP_fillTileMapRect(BG_B, wall, OFFSET_X, OFFSET_Y+ARENA_H-1, ARENA_W, 1);
+    VDP_fillTileMapRect(BG_B, wall, OFFSET_X, OFFSET_Y+1, 1, ARENA_H-2);
+    VDP_fillTileMapRect(BG_B, wall, OFFSET_X+ARENA_W-1, OFFSET_Y+1, 1, ARENA_H-2);
 }
 
 // ============= GAME =============
 
-static u16 rnd(void) { 
-    seed = seed * 1103515245 + 12345; 
-    return (seed >> 16) & 0x7FFF; 
-}
-
 static void createTiles(void) {
-    u32 td[8];
-    
-    memset(td, 0, 32); 
-    VDP_loadTileData(td, TILE_EMPTY, 1, CPU);
-    
-    // Snake body with pattern
-    td[0] = 0x01111110;
-    td[1] = 0x11111111;
-    td[2] = 0x11111111;
-    td[3] = 0x11111111;
-    td[4] = 0x11111111;
-    td[5] = 0x11111111;
-    td[6] = 0x11111111;
-    td[7] = 0x01111110;
-    VDP_loadTileData(td, TILE_SNAKE1, 1, CPU);
-    
-    td[0] = 0x02222220;
-    td[1] = 0x22222222;
-    td[2] = 0x22222222;
-    td[3] = 0x22222222;
-    td[4] = 0x22222222;
-    td[5] = 0x22222222;
-    td[6] = 0x22222222;
-    td[7] = 0x02222220;
-    VDP_loadTileData(td, TILE_SNAKE2, 1, CPU);
-    
-    // Food - apple shape
-    td[0] = 0x00033000;
-    td[1] = 0x00033000;
-    td[2] = 0x03333330;
-    td[3] = 0x33433333;
-    td[4] = 0x33333333;
-    td[5] = 0x33333333;
-    td[6] = 0x03333330;
-    td[7] = 0x00333300;
-    VDP_loadTileData(td, TILE_FOOD, 1, CPU);
-    
-    // Wall - brick pattern
-    td[0] = 0x44444444;
-    td[1] = 0x45454545;
-    td[2] = 0x44444444;
-    td[3] = 0x54545454;
-    td[4] = 0x44444444;
-    td[5] = 0x45454545;
-    td[6] = 0x44444444;
-    td[7] = 0x54545454;
-    VDP_loadTileData(td, TILE_WALL, 1, CPU);
-    
-    // Snake heads with eyes
-    td[0] = 0x01111110;
-    td[1] = 0x11011011;
-    td[2] = 0x11011011;
-    td[3] = 0x11111111;
-    td[4] = 0x11111111;
-    td[5] = 0x11111111;
-    td[6] = 0x11111111;
-    td[7] = 0x01111110;
-    VDP_loadTileData(td, TILE_HEAD1, 1, CPU);
-    
-    td[0] = 0x02222220;
-    td[1] = 0x22022022;
-    td[2] = 0x22022022;
-    td[3] = 0x22222222;
-    td[4] = 0x22222222;
-    td[5] = 0x22222222;
-    td[6] = 0x22222222;
-    td[7] = 0x02222220;
-    VDP_loadTileData(td, TILE_HEAD2, 1, CPU);
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
+    
+    // Food hops in time with its colour pulse
+    TANIM_add(TILE_FOOD, food_anim.tiles, food_anim.numTile, 8, TRUE);
 }
 
 static void spawnFood(void) {
     u8 valid;
     do { 
-        foodX = 1 + rnd() % (ARENA_W-2); 
-        foodY = 1 + rnd() % (ARENA_H-2);
+        foodX = 1 + RNG_range(RNG_GAME, ARENA_W-2); 
+        foodY = 1 + RNG_range(RNG_GAME, ARENA_H-2);
         valid = TRUE;
         // Don't spawn on snake
         for (u8 i = 0; i < len1 && valid; i++) {
@@ -191,13 +141,16 @@ static void spawnFood(void) {
             if (snake2X[i] == foodX && snake2Y[i] == foodY) valid = FALSE;
         }
     } while(!valid);
-    foodAnim = 0;
 }
 
 static void initGame(u8 mode) {
+    // Food placement depends only on this seed, so a game can be replayed
+    RNG_init(frameCount);
+    INPUT_clear();
     gameMode = mode;
     score = 0;
     speed = 8;
+    moveTimer = 0;
     combo = 0;
     comboTimer = 0;
     
@@ -210,8 +163,17 @@ static void initGame(u8 mode) {
     } else { alive2 = 0; }
     
     spawnFood();
+    drawWalls();
+    PFX_stopAll();
+    PFX_pulse(3, RGB24_TO_VDPCOLOR(0xFF8888), 16);  // Food
+    HUD_clear();
+    HUD_drawText("SCORE:", 1, 1);
+    HUD_drawText("LEN:", 15, 1);
+    HUD_drawText("HI:", 30, 1);
+    HUD_show(TRUE);
     gameState = 1;
-    sfxSilence();
+    playMusic();
+    SFX_stopAll();
 }
 
 static void moveSnake(s8* sx, s8* sy, u8* len, u8 dir, u8* alive, u8 ate) {
@@ -262,20 +224,20 @@ static void moveSnake(s8* sx, s8* sy, u8* len, u8 dir, u8* alive, u8 ate) {
     sx[0] = nx; sy[0] = ny;
 }
 
-static void update(void) {
-    u16 joy1 = JOY_readJoypad(JOY_1);
-    if ((joy1 & BUTTON_UP) && dir1 != 2) ndir1 = 0;
-    if ((joy1 & BUTTON_RIGHT) && dir1 != 3) ndir1 = 1;
-    if ((joy1 & BUTTON_DOWN) && dir1 != 0) ndir1 = 2;
-    if ((joy1 & BUTTON_LEFT) && dir1 != 1) ndir1 = 3;
-    
-    if (gameMode == 1 && alive2) {
-        u16 joy2 = JOY_readJoypad(JOY_2);
-        if ((joy2 & BUTTON_UP) && dir2 != 2) ndir2 = 0;
-        if ((joy2 & BUTTON_RIGHT) && dir2 != 3) ndir2 = 1;
-        if ((joy2 & BUTTON_DOWN) && dir2 != 0) ndir2 = 2;
-        if ((joy2 & BUTTON_LEFT) && dir2 != 1) ndir2 = 3;
+// Next queued turn off 'pad' that is neither straight on nor a reversal.
+// One turn per move, so a quick double turn lands over two moves.
+static u8 nextDir(u16 pad, u8 dir) {
+    u16 button;
+    while ((button = INPUT_popDir(pad))) {
+        u8 d = (button == BUTTON_UP) ? 0 : (button == BUTTON_RIGHT) ? 1 : (button == BUTTON_DOWN) ? 2 : 3;
+        if (d != dir && d != ((dir + 2) & 3)) return d;
     }
+    return dir;
+}
+
+static void update(void) {
+    ndir1 = nextDir(JOY_1, dir1);
+    if (gameMode == 1 && alive2) ndir2 = nextDir(JOY_2, dir2);
     
     dir1 = ndir1; dir2 = ndir2;
     
@@ -315,148 +277,145 @@ static void update(void) {
     
     if (!alive1 && (gameMode == 0 || !alive2)) {
         if (score > highScore) highScore = score;
+        sprintf(scoreText, "Score: %d", score);
         gameState = 2;
+        AUD_stopMusic();
     }
     if (gameMode == 1 && (!alive1 || !alive2)) {
         gameState = 2;
+        AUD_stopMusic();
     }
+    
+    // Dim the arena under the game over box
+    if (gameState == 2) PFX_fade(16, 48, 0, 8, 30);
 }
 
 static void draw(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    
-    // Border
-    for (u8 x = 0; x < ARENA_W; x++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL), OFFSET_X+x, OFFSET_Y);
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL), OFFSET_X+x, OFFSET_Y+ARENA_H-1);
-    }
-    for (u8 y = 0; y < ARENA_H; y++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL), OFFSET_X, OFFSET_Y+y);
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL), OFFSET_X+ARENA_W-1, OFFSET_Y+y);
-    }
+    TMAP_clear();
     
     // Snake 1
     if (alive1) {
         // Head
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_HEAD1), 
-                        OFFSET_X+snake1X[0], OFFSET_Y+snake1Y[0]);
+        TMAP_setTile(TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_HEAD1),
+                     OFFSET_X+snake1X[0], OFFSET_Y+snake1Y[0]);
         // Body
         for (u8 i = 1; i < len1; i++) {
-            VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_SNAKE1), 
-                            OFFSET_X+snake1X[i], OFFSET_Y+snake1Y[i]);
+            TMAP_setTile(TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_SNAKE1),
+                         OFFSET_X+snake1X[i], OFFSET_Y+snake1Y[i]);
         }
     }
     
     // Snake 2
     if (alive2) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_HEAD2), 
-                        OFFSET_X+snake2X[0], OFFSET_Y+snake2Y[0]);
+        TMAP_setTile(TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_HEAD2),
+                     OFFSET_X+snake2X[0], OFFSET_Y+snake2Y[0]);
         for (u8 i = 1; i < len2; i++) {
-            VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_SNAKE2), 
-                            OFFSET_X+snake2X[i], OFFSET_Y+snake2Y[i]);
+            TMAP_setTile(TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_SNAKE2),
+                         OFFSET_X+snake2X[i], OFFSET_Y+snake2Y[i]);
         }
     }
     
-    // Food with pulsing animation
-    foodAnim++;
-    u8 foodPal = ((foodAnim / 8) % 2) ? PAL0 : PAL1;
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(foodPal, 0, 0, 0, TILE_FOOD), OFFSET_X+foodX, OFFSET_Y+foodY);
+    // Food (pulses through its palette entry)
+    TMAP_setTile(TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_FOOD), OFFSET_X+foodX, OFFSET_Y+foodY);
     
     // HUD
-    char buf[20];
-    sprintf(buf, "SCORE:%d", score);
-    VDP_drawText(buf, 1, 1);
-    
-    sprintf(buf, "HI:%d", highScore);
-    VDP_drawText(buf, 30, 1);
-    
-    sprintf(buf, "LEN:%d", len1);
-    VDP_drawText(buf, 15, 1);
+    HUD_setCounter(HUD_SCORE, score);
+    HUD_setCounter(HUD_HI, highScore);
+    HUD_setCounter(HUD_LEN, len1);
     
     // Combo display
     if (combo >= 2 && comboTimer > 0) {
-        sprintf(buf, "x%d COMBO!", combo);
-        VDP_drawText(buf, 15, OFFSET_Y + ARENA_H);
+        HUD_drawText("x", 15, 2);
+        HUD_setCounter(HUD_COMBO, combo);
+        HUD_drawText("COMBO!", 19, 2);
+    } else {
+        HUD_clearText(15, 2, 10);
+        HUD_hideCounter(HUD_COMBO);
     }
     
     // Speed indicator
     if (speed <= 4) {
-        VDP_drawText("TURBO!", 34, 1);
+        HUD_drawText("TURBO!", 34, 2);
+    } else {
+        HUD_clearText(34, 2, 6);
     }
 }
 
-static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    
-    // Pulsing title color
-    if (titleAnim % 30 < 15) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0x00FF00));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0x88FF88));
-    }
-    
+// Static title text, sent to BG_B once on entering the title
+static const ScreenText titleScreen[] = {
     // Standard title block
-    VDP_drawText("====================", 10, 4);
-    VDP_drawText("    SNAKE ARENA     ", 10, 5);
-    VDP_drawText("====================", 10, 6);
-    VDP_drawText("Free Retro Games", 12, 8);
-    VDP_drawText("v1.0.0", 17, 9);
-    
-    // Animated snake
-    u8 snakeY = 11 + ((frameCount / 12) % 2);
-    for (u8 i = 0; i < 6; i++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL2, 0, 0, 0, i == 0 ? TILE_HEAD1 : TILE_SNAKE1), 
-                        14 + i, snakeY);
-    }
+    { 10,  4, "====================" },
+    { 10,  5, "    SNAKE ARENA     " },
+    { 10,  6, "====================" },
+    { 12,  8, "Free Retro Games" },
+    { 17,  9, "v1.0.0" },
     
     // Player select
-    VDP_drawText("--------------------", 10, 13);
-    VDP_drawText("START - 1 Player", 12, 15);
-    VDP_drawText("    A - 2 Players", 12, 17);
-    VDP_drawText("--------------------", 10, 19);
+    { 10, 13, "--------------------" },
+    { 12, 15, "START - 1 Player" },
+    { 12, 17, "    A - 2 Players" },
+    { 10, 19, "--------------------" },
     
     // High score
-    char buf[24];
-    sprintf(buf, "High Score: %d", highScore);
-    VDP_drawText(buf, 13, 21);
-    
-    // Sound toggle
-    VDP_drawText("C: Sound", 16, 23);
-    VDP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
+    { 13, 21, hiScoreText },
+    { 16, 23, "C: Sound" },
     
     // Footer
-    VDP_drawText("(C) 2026 monteslu", 11, 27);
+    { 11, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+// Static text is in titleScreen, only what moves or toggles is drawn here
+static void drawTitle(void) {
+    TMAP_clear();
+    
+    // Animated snake, bobs every 12 frames
+    if (titleTimer) titleTimer--;
+    else {
+        titleTimer = 11;
+        titleBob ^= 1;
+    }
+    u8 snakeY = 11 + titleBob;
+    for (u8 i = 0; i < 6; i++) {
+        TMAP_setTile(TILE_ATTR_FULL(PAL2, 0, 0, 0, i == 0 ? TILE_HEAD1 : TILE_SNAKE1),
+                     14 + i, snakeY);
+    }
+    
+    // Sound toggle
+    TMAP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
 }
 
 static void drawGameOver(void) {
     // Draw over the game
-    VDP_drawText("================", 12, 10);
+    TMAP_drawText("================", 12, 10);
     
     if (gameMode == 0) {
-        VDP_drawText("   GAME OVER   ", 12, 12);
-        char buf[20];
-        sprintf(buf, "Score: %d", score);
-        VDP_drawText(buf, 15, 14);
+        TMAP_drawText("   GAME OVER   ", 12, 12);
+        TMAP_drawText(scoreText, 15, 14);
         if (score >= highScore) {
-            VDP_drawText("NEW HIGH SCORE!", 12, 16);
+            TMAP_drawText("NEW HIGH SCORE!", 12, 16);
         }
     } else {
         if (alive1) {
-            VDP_drawText(" PLAYER 1 WINS! ", 12, 12);
+            TMAP_drawText(" PLAYER 1 WINS! ", 12, 12);
         } else if (alive2) {
-            VDP_drawText(" PLAYER 2 WINS! ", 12, 12);
+            TMAP_drawText(" PLAYER 2 WINS! ", 12, 12);
         } else {
-            VDP_drawText("   IT'S A TIE!  ", 12, 12);
+            TMAP_drawText("   IT'S A TIE!  ", 12, 12);
         }
     }
     
-    VDP_drawText("================", 12, 18);
-    VDP_drawText("Press START", 14, 22);
+    TMAP_drawText("================", 12, 18);
+    TMAP_drawText("Press START", 14, 22);
 }
 
+// Play frame for the cycle benchmark: the move pacing
+static const BenchProfile benchProfile = { 1, 1, 0, 0, 0 };
+
 int main(void) {
     VDP_setScreenWidth320();
     PAL_setColor(0, RGB24_TO_VDPCOLOR(0x000011));  // Dark blue BG
+    PAL_setColor(1, RGB24_TO_VDPCOLOR(0x00FF00));  // Text green
     PAL_setColor(3, RGB24_TO_VDPCOLOR(0xFF0000));  // Food red
     PAL_setColor(4, RGB24_TO_VDPCOLOR(0xFFFFFF));  // Food highlight
     
@@ -466,39 +425,63 @@ int main(void) {
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0x00FF00)); // P1 green
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0x00AAFF)); // P2 blue
     
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("SNAKE ARENA", &benchProfile);
+    
+    RNG_init(54321);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    TANIM_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    TMAP_init(BG_A, TMAP_DOUBLE_BUFFER);
+    HUD_init(FALSE, 3);
+    HUD_setupCounter(HUD_SCORE, 7, 1, 5, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LEN, 19, 1, 3, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_HI, 33, 1, 5, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_COMBO, 16, 2, 2, HUD_ALIGN_LEFT);
+    sprintf(hiScoreText, "High Score: %d", highScore);
     gameState = 0;
-    titleAnim = 0;
-    shakeX = shakeY = 0;
-    shakeTimer = 0;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0x88FF88), 30);  // Pulsing title color
+    SCRN_load(BG_B, titleScreen);
     
-    u16 lastJoy = 0;
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy; 
-        seed += frameCount;
-        
-        updateShake();
-        if (frameCount % 8 == 0) sfxSilence();
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
         
         if (gameState == 0) {
-            if (titleAnim < 80) titleAnim++;
             if (pressed & BUTTON_START) initGame(0);
             if (pressed & BUTTON_A) initGame(1);
-            drawTitle();
+            // A new state has drawn its own screen already
+            if (gameState == 0) drawTitle();
         } else if (gameState == 1) {
-            if (frameCount % speed == 0) update();
+            while (ticks-- && gameState == 1) {
+                if (moveTimer) moveTimer--;
+                else {
+                    moveTimer = speed - 1;
+                    update();
+                }
+            }
             draw();
         } else {
             drawGameOver();
             if (pressed & BUTTON_START) {
                 gameState = 0;
-                titleAnim = 0;
+                HUD_show(FALSE);
+                PFX_stopAll();
+                PFX_pulse(1, RGB24_TO_VDPCOLOR(0x88FF88), 30);
+                sprintf(hiScoreText, "High Score: %d", highScore);
+                SCRN_load(BG_B, titleScreen);
             }
         }
         frameCount++;
+        TMAP_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     return 0;
 }
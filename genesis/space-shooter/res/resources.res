@@ -1 +1,14 @@
 # Space Shooter resources
+
+# All game tiles in tile index order (tiles.png, 8x8 each, left to right).
+# NONE keeps the order so the TILE_* defines in main.c stay valid.
+TILESET game_tiles "tiles.png" BEST NONE
+
+# Animation frames are streamed straight from ROM, so no compression
+TILESET explode_anim "explode.png" NONE NONE
+
+# Explosion sample, mixed by the Z80 driver
+WAV explode_pcm "explode.wav" XGM2
+
+# In-game music, a YM2612 log converted for the Z80 driver
+XGM2 game_music "game.vgm"
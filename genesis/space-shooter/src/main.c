@@ -4,29 +4,59 @@
  */
 
 #include <genesis.h>
-
-#define TILE_EMPTY   0
-#define TILE_PLAYER  1
-#define TILE_BULLET  2
-#define TILE_ENEMY   3
-#define TILE_EXPLODE1 4
-#define TILE_EXPLODE2 5
-#define TILE_EXPLODE3 6
-#define TILE_STAR    7
-#define TILE_POWERUP 8
+#include "resources.h"
+
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/fastdiv.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/kinematics.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/particles.h"
+#include "common/pool.h"
+#include "common/rng.h"
+#include "common/sched.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/sprites.h"
+#include "common/tileanim.h"
+#include "common/tilemap.h"
+#include "common/trig.h"
+#include "common/vram.h"
+
+#define TILE_EMPTY   (gameTiles + 0)
+#define TILE_PLAYER  (gameTiles + 1)
+#define TILE_BULLET  (gameTiles + 2)
+#define TILE_ENEMY   (gameTiles + 3)
+#define TILE_EXPLODE (gameTiles + 4)  // animated in VRAM, see res/explode.png
+#define TILE_STAR    (gameTiles + 5)
+#define TILE_POWERUP (gameTiles + 6)
+#define TILE_DEBRIS  (gameTiles + 7)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
 
 #define ARENA_W      40
 #define ARENA_H      28
-#define MAX_BULLETS  12
-#define MAX_ENEMIES  15
-#define MAX_EXPLOSIONS 10
+#define MAX_BULLETS  16
+#define MAX_ENEMIES  24
 #define MAX_STARS    30
+#define MAX_SHOTS    8
+#define SHOT_SPEED   FIX16(2)   // enemy shots, pixels per frame
 
-typedef struct {
-    s16 x, y;
-    u8 frame;
-    u8 timer;
-} Explosion;
+// CRAM entries used by palette effects
+#define PLAYER_COLOR 33
+#define POWERUP_COLORS 49   // three entries cycled for the power-up shimmer
+
+// HUD counters (top two rows)
+#define HUD_SCORE    0
+#define HUD_LEVEL    1
+#define HUD_LIVES    2
+#define HUD_COMBO    3
 
 typedef struct {
     s16 x, y;
@@ -35,25 +65,31 @@ typedef struct {
 
 static s16 playerX, playerY;
 static s16 bulletX[MAX_BULLETS], bulletY[MAX_BULLETS];
-static u8 bulletActive[MAX_BULLETS];
 static s16 enemyX[MAX_ENEMIES], enemyY[MAX_ENEMIES];
-static u8 enemyActive[MAX_ENEMIES];
 static u8 enemyHP[MAX_ENEMIES];
-static Explosion explosions[MAX_EXPLOSIONS];
+static KinBody shots[MAX_SHOTS];     // aimed enemy shots, in pixels
+
+// Live slots of the arrays above
+POOL_DEFINE(bulletPool, MAX_BULLETS);
+POOL_DEFINE(enemyPool, MAX_ENEMIES);
+POOL_DEFINE(shotPool, MAX_SHOTS);
 static Star stars[MAX_STARS];
 static u8 fireCooldown;
-static u16 score;
+static u32 score;
 static u8 gameState;
 static u16 frameCount;
-static u16 seed = 34463;
 
 // PIZZAZZ!
 static u8 soundEnabled = 1;
-static s16 shakeX = 0, shakeY = 0;
-static u8 shakeTimer = 0;
-static u16 highScore = 0;
-static u8 titleFrame = 0;
-static u8 playerFlash = 0;
+static u32 highScore = 0;
+static bool newHighScore = FALSE;
+// Formatted once per state change rather than every frame
+static char hiScoreText[28];
+static char finalText[3][28];
+static u8 titleTimer = 0;      // frames until the title ship bobs
+static u8 titleStep = 0;
+static u8 enemyTimer = 0;      // frames until enemies step down
+static u8 spawnTimer = 0;      // frames until the next enemy
 static u8 combo = 0;
 static u8 comboTimer = 0;
 static u8 level = 1;
@@ -64,122 +100,89 @@ static u8 rapidFire = 0;
 static u8 lives = 3;
 static u8 invincible = 0;
 
-static u16 rnd() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7FFF; }
-
 // ============ SOUND EFFECTS ============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+static const SfxStep shootSteps[] = { { 1200, 13, 4, -40, 1 }, SFX_END };
+static const SfxStep boomSteps[] = { { 80, 15, 12, -2, 1 }, SFX_END };
+static const SfxStep hitSteps[] = { { 400, 13, 4, 0, 1 }, SFX_END };
+static const SfxStep powerUpSteps[] = {
+    { 800, 15, 4, 0, 0 }, { 1100, 15, 4, 0, 0 }, { 1400, 15, 8, 0, 1 }, SFX_END
+};
+static const SfxStep deathSteps[] = {
+    { 300, 15, 5, 0, 0 }, { 250, 15, 5, 0, 0 }, { 200, 15, 5, 0, 0 }, { 150, 15, 15, 0, 1 }, SFX_END
+};
+static const SfxStep blipSteps[] = { { 1000, 12, 3, 0, 1 }, SFX_END };
+static const SfxStep comboSteps[] = { { 1400, 14, 6, 20, 1 }, SFX_END };
+
+static const Sfx sfxShoot = { SFX_PRIO_LOW, FALSE, shootSteps };
+static const Sfx sfxBoom = { SFX_PRIO_HIGH, FALSE, boomSteps };
+static const Sfx sfxHit = { SFX_PRIO_MID, FALSE, hitSteps };
+static const Sfx sfxPowerUp = { SFX_PRIO_HIGH, FALSE, powerUpSteps };
+static const Sfx sfxDeath = { SFX_PRIO_JINGLE, FALSE, deathSteps };
+static const Sfx sfxBlip = { SFX_PRIO_LOW, FALSE, blipSteps };
+static const Sfx sfxCombo = { SFX_PRIO_MID, FALSE, comboSteps };
+
 static void playShoot() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1200);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 4);
+    SFX_play(&sfxShoot);
 }
 
 static void playExplosion() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 80 + (rnd() % 40));
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 10);
-    PSG_setEnvelope(3, PSG_ENVELOPE_MAX);
-    PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_CLOCK4);
+    SFX_playPitch(&sfxBoom, RNG_range(RNG_FX, 40));
+    AUD_PLAY_PCM(explode_pcm, SFX_PRIO_HIGH);
 }
 
 static void playHit() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(2, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(2, 400);
-    PSG_setEnvelope(2, PSG_ENVELOPE_MIN + 5);
+    SFX_play(&sfxHit);
 }
 
 static void playPowerUp() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 3; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 800 + i * 300);
-        for (u16 j = 0; j < 2000; j++) {}
-    }
+    SFX_play(&sfxPowerUp);
 }
 
 static void playDeath() {
     if (!soundEnabled) return;
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 300 - i * 50);
-        PSG_setEnvelope(3, PSG_ENVELOPE_MAX);
-        PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_CLOCK4);
-        for (u16 j = 0; j < 3000; j++) {}
-    }
+    SFX_play(&sfxDeath);
+    AUD_PLAY_PCM(explode_pcm, SFX_PRIO_JINGLE);
 }
 
 static void playMenuBlip() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1000);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 2);
+    SFX_play(&sfxBlip);
 }
 
 static void playCombo() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1400 + combo * 100);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 3);
+    SFX_playPitch(&sfxCombo, combo * 100);
 }
 
-static void updateSound() {
-    static u8 fadeTimer = 0;
-    fadeTimer++;
-    if (fadeTimer > 2) {
-        fadeTimer = 0;
-        for (u8 ch = 0; ch < 4; ch++) {
-            PSG_setEnvelope(ch, PSG_ENVELOPE_MIN);
-        }
-    }
+// Background track, on the Z80 for the whole game
+static void playMusic() {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============ SCREEN SHAKE ============
 static void startShake(u8 intensity) {
-    shakeTimer = intensity;
-}
-
-static void updateShake() {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeY = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeTimer--;
-    } else {
-        shakeX = shakeY = 0;
-    }
-    VDP_setHorizontalScroll(BG_A, shakeX);
-    VDP_setVerticalScroll(BG_A, shakeY);
+    SCRL_shake(SCRL_LAYER_A, intensity, intensity);
 }
 
 // ============ EXPLOSIONS ============
+// A burning cell plus a spray of debris sprites
 static void spawnExplosion(s16 x, s16 y) {
-    for (u8 i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (explosions[i].timer == 0) {
-            explosions[i].x = x;
-            explosions[i].y = y;
-            explosions[i].frame = 0;
-            explosions[i].timer = 15;
-            return;
-        }
-    }
-}
-
-static void updateExplosions() {
-    for (u8 i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (explosions[i].timer > 0) {
-            explosions[i].timer--;
-            explosions[i].frame = (15 - explosions[i].timer) / 5;
-        }
-    }
+    PART_spawn(x * 8, y * 8, 0, 0, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_EXPLODE), 15, 0);
+    PART_burst(x * 8, y * 8, 10, FIX16(2), TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_DEBRIS), 20, PART_SPRITE);
 }
 
 // ============ STARS (parallax) ============
 static void initStars() {
     for (u8 i = 0; i < MAX_STARS; i++) {
-        stars[i].x = rnd() % ARENA_W;
-        stars[i].y = rnd() % ARENA_H;
-        stars[i].speed = 1 + (rnd() % 2);
+        stars[i].x = RNG_range(RNG_FX, ARENA_W);
+        stars[i].y = RNG_range(RNG_FX, ARENA_H);
+        stars[i].speed = 1 + RNG_range(RNG_FX, 2);
     }
 }
 
@@ -188,77 +191,22 @@ static void updateStars() {
         stars[i].y += stars[i].speed;
         if (stars[i].y >= ARENA_H) {
             stars[i].y = 0;
-            stars[i].x = rnd() % ARENA_W;
+            stars[i].x = RNG_range(RNG_FX, ARENA_W);
         }
     }
 }
 
 static void createTiles() {
-    u32 td[8];
-    memset(td, 0, 32); VDP_loadTileData(td, TILE_EMPTY, 1, CPU);
-    
-    // Player ship (triangle pointing up)
-    memset(td, 0, 32);
-    td[0] = 0x00011000;
-    td[1] = 0x00111100;
-    td[2] = 0x01111110;
-    td[3] = 0x11111111;
-    td[4] = 0x11111111;
-    td[5] = 0x01100110;
-    td[6] = 0x01000010;
-    VDP_loadTileData(td, TILE_PLAYER, 1, CPU);
-    
-    // Bullet
-    memset(td, 0, 32);
-    td[2] = 0x00011000;
-    td[3] = 0x00011000;
-    td[4] = 0x00011000;
-    td[5] = 0x00011000;
-    VDP_loadTileData(td, TILE_BULLET, 1, CPU);
-    
-    // Enemy (invader style)
-    memset(td, 0, 32);
-    td[1] = 0x01000010;
-    td[2] = 0x00111100;
-    td[3] = 0x01111110;
-    td[4] = 0x11011011;
-    td[5] = 0x11111111;
-    td[6] = 0x01011010;
-    VDP_loadTileData(td, TILE_ENEMY, 1, CPU);
-    
-    // Explosion frames
-    memset(td, 0, 32);
-    td[3] = 0x00033000;
-    td[4] = 0x00033000;
-    VDP_loadTileData(td, TILE_EXPLODE1, 1, CPU);
-    
-    memset(td, 0, 32);
-    td[2] = 0x00333300;
-    td[3] = 0x03333330;
-    td[4] = 0x03333330;
-    td[5] = 0x00333300;
-    VDP_loadTileData(td, TILE_EXPLODE2, 1, CPU);
-    
-    memset(td, 0x33, 32);
-    VDP_loadTileData(td, TILE_EXPLODE3, 1, CPU);
-    
-    // Star
-    memset(td, 0, 32);
-    td[3] = 0x00001000;
-    VDP_loadTileData(td, TILE_STAR, 1, CPU);
-    
-    // Power-up
-    memset(td, 0, 32);
-    td[1] = 0x00222200;
-    td[2] = 0x02222220;
-    td[3] = 0x22222222;
-    td[4] = 0x22222222;
-    td[5] = 0x02222220;
-    td[6] = 0x00222200;
-    VDP_loadTileData(td, TILE_POWERUP, 1, CPU);
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
+    
+    // Explosion (5 frames per step, looping)
+    TANIM_add(TILE_EXPLODE, explode_anim.tiles, explode_anim.numTile, 5, TRUE);
 }
 
 static void initGame() {
+    // Gameplay and AI draws depend only on this seed, so a game can be replayed
+    RNG_init(frameCount);
     playerX = ARENA_W / 2;
     playerY = ARENA_H - 3;
     score = 0;
@@ -272,28 +220,35 @@ static void initGame() {
     comboTimer = 0;
     powerUpActive = 0;
     
-    for (u8 i = 0; i < MAX_BULLETS; i++) bulletActive[i] = 0;
-    for (u8 i = 0; i < MAX_ENEMIES; i++) enemyActive[i] = 0;
-    for (u8 i = 0; i < MAX_EXPLOSIONS; i++) explosions[i].timer = 0;
+    POOL_init(&bulletPool);
+    POOL_init(&enemyPool);
+    POOL_init(&shotPool);
+    PART_clear();
+    VDP_clearPlane(BG_B, TRUE);  // drop the title text
     
     initStars();
+    PFX_stopAll();
+    PFX_cycle(POWERUP_COLORS, 3, 4);
+    HUD_clear();
+    HUD_drawText("SCORE:", 1, 0);
+    HUD_drawText("LV:", 16, 0);
+    HUD_drawText("LIVES:", 26, 0);
+    HUD_show(TRUE);
     gameState = 1;
+    playMusic();
 }
 
 static void spawnEnemy() {
-    for (u8 i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemyActive[i]) {
-            enemyX[i] = 2 + rnd() % (ARENA_W - 4);
-            enemyY[i] = 0;
-            enemyActive[i] = 1;
-            enemyHP[i] = 1 + (level / 3);  // Tougher enemies in later levels
-            return;
-        }
-    }
+    u8 i = POOL_alloc(&enemyPool);
+    if (i == POOL_NONE) return;
+    
+    enemyX[i] = 2 + RNG_range(RNG_GAME, ARENA_W - 4);
+    enemyY[i] = 0;
+    enemyHP[i] = 1 + (level / 3);  // Tougher enemies in later levels
 }
 
 static void spawnPowerUp(s16 x, s16 y) {
-    if (!powerUpActive && (rnd() % 5) == 0) {  // 20% chance
+    if (!powerUpActive && RNG_chance(RNG_GAME, 5)) {  // 20% chance
         powerUpX = x;
         powerUpY = y;
         powerUpActive = 1;
@@ -304,20 +259,71 @@ static void fireBullet() {
     u8 cooldown = rapidFire ? 3 : 8;
     if (fireCooldown > 0) return;
     
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        if (!bulletActive[i]) {
-            bulletX[i] = playerX;
-            bulletY[i] = playerY - 1;
-            bulletActive[i] = 1;
-            fireCooldown = cooldown;
-            playShoot();
-            return;
+    u8 i = POOL_alloc(&bulletPool);
+    if (i == POOL_NONE) return;
+    
+    bulletX[i] = playerX;
+    bulletY[i] = playerY - 1;
+    fireCooldown = cooldown;
+    playShoot();
+}
+
+// Lose a life; TRUE if that was the last one
+static bool hitPlayer() {
+    lives--;
+    invincible = 90;  // 1.5 sec invincibility
+    PFX_flash(PLAYER_COLOR, RGB24_TO_VDPCOLOR(0xFFFFFF), 30, 1);
+    SCRL_wobble(SCRL_LAYER_A, 6, 45);
+    playDeath();
+    spawnExplosion(playerX, playerY);
+    
+    if (lives <= 0) {
+        gameState = 2;
+        AUD_stopMusic();
+        PART_clear();
+        sprintf(finalText[0], "Final Score: %lu", score);
+        sprintf(finalText[1], "Level Reached: %d", level);
+        sprintf(finalText[2], "Enemies Destroyed: %d", enemiesKilled);
+        newHighScore = score > highScore;
+        if (newHighScore) highScore = score;
+        PFX_fade(16, 48, 0, 8, 30);  // Dim the playfield under the text
+        return TRUE;
+    }
+    return FALSE;
+}
+
+// Enemy shot from cell (x, y), aimed where the player is now
+static void fireShot(s16 x, s16 y) {
+    u8 i = POOL_alloc(&shotPool);
+    if (i == POOL_NONE) return;
+    
+    u8 angle = TRIG_atan2(playerY - y, playerX - x);
+    KIN_set(&shots[i], x * 8, y * 8, 0, 0);
+    TRIG_polar(angle, SHOT_SPEED, &shots[i].vx, &shots[i].vy);
+}
+
+// TRUE if a shot hit the player and that ended the game
+static bool updateShots() {
+    for (u16 n = POOL_COUNT(&shotPool); n--; ) {
+        u8 i = POOL_AT(&shotPool, n);
+        
+        KIN_step(&shots[i]);
+        s16 x = KIN_X(&shots[i]), y = KIN_Y(&shots[i]);
+        if (x < -8 || x >= ARENA_W * 8 || y < 0 || y >= ARENA_H * 8) {
+            POOL_free(&shotPool, i);
+            continue;
+        }
+        
+        if (!invincible && abs(x - playerX * 8) < 6 && abs(y - playerY * 8) < 6) {
+            POOL_free(&shotPool, i);
+            if (hitPlayer()) return TRUE;
         }
     }
+    return FALSE;
 }
 
 static void update() {
-    u16 joy = JOY_readJoypad(JOY_1);
+    u16 joy = INPUT_held(JOY_1);
     
     // Player movement (faster!)
     if (joy & BUTTON_LEFT) playerX -= 2;
@@ -340,11 +346,10 @@ static void update() {
     else combo = 0;
     
     // Update bullets
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        if (bulletActive[i]) {
-            bulletY[i] -= 2;  // Faster bullets
-            if (bulletY[i] < 0) bulletActive[i] = 0;
-        }
+    for (u16 n = POOL_COUNT(&bulletPool); n--; ) {
+        u8 i = POOL_AT(&bulletPool, n);
+        bulletY[i] -= 2;  // Faster bullets
+        if (bulletY[i] < 0) POOL_free(&bulletPool, i);
     }
     
     // Update power-up
@@ -361,75 +366,81 @@ static void update() {
         }
     }
     
+    // Update enemy shots
+    if (updateShots()) return;
+    
     // Update enemies
     u8 enemySpeed = 4 + level;  // Faster in later levels
-    for (u8 i = 0; i < MAX_ENEMIES; i++) {
-        if (enemyActive[i]) {
-            if (frameCount % enemySpeed == 0) enemyY[i]++;
-            
-            if (enemyY[i] >= ARENA_H - 1) {
-                enemyActive[i] = 0;
-            }
-            
-            // Hit player (if not invincible)
-            if (!invincible && abs(enemyX[i] - playerX) < 2 && abs(enemyY[i] - playerY) < 2) {
-                lives--;
-                invincible = 90;  // 1.5 sec invincibility
-                playerFlash = 30;
-                startShake(8);
-                playDeath();
-                spawnExplosion(playerX, playerY);
+    u16 shotOdds = (level < 8) ? 300 - level * 25 : 100;  // Shoot more in later levels
+    bool enemyStep = FALSE;
+    if (enemyTimer) enemyTimer--;
+    else {
+        enemyTimer = enemySpeed - 1;
+        enemyStep = TRUE;
+    }
+    for (u16 n = POOL_COUNT(&enemyPool); n--; ) {
+        u8 i = POOL_AT(&enemyPool, n);
+        
+        if (enemyStep) enemyY[i]++;
+        
+        if (enemyY[i] >= ARENA_H - 1) {
+            POOL_free(&enemyPool, i);
+            continue;
+        }
+        
+        // Hit player (if not invincible)
+        if (!invincible && abs(enemyX[i] - playerX) < 2 && abs(enemyY[i] - playerY) < 2) {
+            if (hitPlayer()) return;
+        }
+        
+        // Shoot at the player now and then from level 2 on
+        if (level >= 2 && enemyY[i] < playerY - 3 && RNG_chance(RNG_AI, shotOdds)) {
+            fireShot(enemyX[i], enemyY[i]);
+        }
+        
+        // Hit by bullet
+        for (u16 m = POOL_COUNT(&bulletPool); m--; ) {
+            u8 j = POOL_AT(&bulletPool, m);
+            if (abs(bulletX[j] - enemyX[i]) < 2 && 
+                abs(bulletY[j] - enemyY[i]) < 2) {
                 
-                if (lives <= 0) {
-                    gameState = 2;
-                    return;
-                }
-            }
-            
-            // Hit by bullet
-            for (u8 j = 0; j < MAX_BULLETS; j++) {
-                if (bulletActive[j] && 
-                    abs(bulletX[j] - enemyX[i]) < 2 && 
-                    abs(bulletY[j] - enemyY[i]) < 2) {
-                    
-                    bulletActive[j] = 0;
-                    enemyHP[i]--;
+                POOL_free(&bulletPool, j);
+                enemyHP[i]--;
+                
+                if (enemyHP[i] <= 0) {
+                    POOL_free(&enemyPool, i);
                     
-                    if (enemyHP[i] <= 0) {
-                        enemyActive[i] = 0;
-                        
-                        // Combo system
-                        if (comboTimer > 0) {
-                            combo++;
-                            if (combo >= 3) {
-                                playCombo();
-                            }
-                        } else {
-                            combo = 1;
-                        }
-                        comboTimer = 45;  // ~0.75 sec window
-                        
-                        // Score with combo bonus
-                        u16 points = 10 * level * (1 + combo / 2);
-                        score += points;
-                        
-                        enemiesKilled++;
-                        
-                        spawnExplosion(enemyX[i], enemyY[i]);
-                        spawnPowerUp(enemyX[i], enemyY[i]);
-                        playExplosion();
-                        startShake(2);
-                        
-                        // Level up every 10 kills
-                        if (enemiesKilled % 10 == 0) {
-                            level++;
-                            startShake(5);
+                    // Combo system
+                    if (comboTimer > 0) {
+                        combo++;
+                        if (combo >= 3) {
+                            playCombo();
                         }
                     } else {
-                        playHit();
+                        combo = 1;
                     }
-                    break;
+                    comboTimer = 45;  // ~0.75 sec window
+                    
+                    // Score with combo bonus
+                    u16 points = 10 * level * (1 + combo / 2);
+                    score += points;
+                    
+                    enemiesKilled++;
+                    
+                    spawnExplosion(enemyX[i], enemyY[i]);
+                    spawnPowerUp(enemyX[i], enemyY[i]);
+                    playExplosion();
+                    startShake(2);
+                    
+                    // Level up every 10 kills
+                    if (enemiesKilled % 10 == 0) {
+                        level++;
+                        startShake(5);
+                    }
+                } else {
+                    playHit();
                 }
+                break;
             }
         }
     }
@@ -437,124 +448,123 @@ static void update() {
     // Spawn enemies (more frequent in later levels)
     u8 spawnRate = 30 - (level * 2);
     if (spawnRate < 10) spawnRate = 10;
-    if (frameCount % spawnRate == 0) spawnEnemy();
-    
-    updateExplosions();
-    updateStars();
+    if (spawnTimer) spawnTimer--;
+    else {
+        spawnTimer = spawnRate - 1;
+        spawnEnemy();
+    }
 }
 
 static void draw() {
-    VDP_clearPlane(BG_A, TRUE);
+    TMAP_clear();
     
     // Stars (background)
     for (u8 i = 0; i < MAX_STARS; i++) {
         u8 pal = stars[i].speed == 1 ? PAL1 : PAL0;
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal, 0, 0, 0, TILE_STAR), stars[i].x, stars[i].y);
+        TMAP_setTile(TILE_ATTR_FULL(pal, 0, 0, 0, TILE_STAR), stars[i].x, stars[i].y);
     }
     
-    // Player (flash when invincible)
-    if (!invincible || frameCount % 4 < 2) {
-        u8 pal = (playerFlash > 0 && frameCount % 2) ? PAL0 : PAL2;
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(pal, 0, 0, 0, TILE_PLAYER), playerX, playerY);
+    // Player (flash when invincible), never flickered out
+    if (!invincible || !(frameCount & 2)) {
+        SPRL_add(playerX * 8, playerY * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_PLAYER), TRUE);
     }
-    if (playerFlash > 0) playerFlash--;
     
     // Bullets
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        if (bulletActive[i])
-            VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BULLET), bulletX[i], bulletY[i]);
+    for (u16 n = 0; n < POOL_COUNT(&bulletPool); n++) {
+        u8 i = POOL_AT(&bulletPool, n);
+        SPRL_add(bulletX[i] * 8, bulletY[i] * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BULLET), FALSE);
     }
     
     // Enemies
-    for (u8 i = 0; i < MAX_ENEMIES; i++) {
-        if (enemyActive[i])
-            VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_ENEMY), enemyX[i], enemyY[i]);
+    for (u16 n = 0; n < POOL_COUNT(&enemyPool); n++) {
+        u8 i = POOL_AT(&enemyPool, n);
+        SPRL_add(enemyX[i] * 8, enemyY[i] * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_ENEMY), FALSE);
     }
     
-    // Power-up (flashing)
-    if (powerUpActive && frameCount % 8 < 6) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_POWERUP), powerUpX, powerUpY);
+    // Enemy shots
+    for (u16 n = 0; n < POOL_COUNT(&shotPool); n++) {
+        u8 i = POOL_AT(&shotPool, n);
+        SPRL_add(KIN_X(&shots[i]), KIN_Y(&shots[i]), SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_BULLET), FALSE);
     }
     
-    // Explosions
-    for (u8 i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (explosions[i].timer > 0) {
-            u8 tile = TILE_EXPLODE1 + explosions[i].frame;
-            VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, 0, 0, 0, tile), explosions[i].x, explosions[i].y);
-        }
+    // Power-up (shimmers through its palette)
+    if (powerUpActive) {
+        SPRL_add(powerUpX * 8, powerUpY * 8, SPRITE_SIZE(1, 1), TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_POWERUP), TRUE);
     }
     
-    // HUD
-    char buf[20];
-    sprintf(buf, "SCORE:%d", score);
-    VDP_drawText(buf, 1, 0);
+    // Explosions and debris
+    PART_draw();
     
-    sprintf(buf, "LV:%d", level);
-    VDP_drawText(buf, 16, 0);
+    // HUD
+    HUD_setCounter(HUD_SCORE, score);
+    HUD_setCounter(HUD_LEVEL, level);
     
     // Lives display
-    sprintf(buf, "LIVES:%d", lives);
-    VDP_drawText(buf, 26, 0);
+    HUD_setCounter(HUD_LIVES, lives);
     
     // Combo display
     if (combo > 1) {
-        sprintf(buf, "x%d!", combo);
-        VDP_drawText(buf, 36, 0);
+        HUD_drawText("x", 36, 0);
+        HUD_setCounter(HUD_COMBO, combo);
+    } else {
+        HUD_clearText(36, 0, 1);
+        HUD_hideCounter(HUD_COMBO);
     }
     
     // Rapid fire indicator
     if (rapidFire > 0) {
-        VDP_drawText("RAPID!", 1, 1);
+        HUD_drawText("RAPID!", 1, 1);
+    } else {
+        HUD_clearText(1, 1, 6);
     }
     
     // Sound indicator
-    VDP_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H - 1);
+    TMAP_drawText(soundEnabled ? "SND" : "---", 1, ARENA_H - 1);
 }
 
-static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    titleFrame++;
-    
-    // Animated stars background
-    updateStars();
-    for (u8 i = 0; i < MAX_STARS; i++) {
-        VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_STAR), stars[i].x, stars[i].y);
-    }
-    
-    // Pulsing title color
-    if (titleFrame % 20 < 10) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFF00));
-    }
-    
+// Static title text, sent to BG_B once on entering the title
+static const ScreenText titleScreen[] = {
     // Standard title block
-    VDP_drawText("====================", 10, 4);
-    VDP_drawText("   SPACE SHOOTER    ", 10, 5);
-    VDP_drawText("====================", 10, 6);
-    VDP_drawText("Free Retro Games", 12, 8);
-    VDP_drawText("v1.0.0", 17, 9);
-    
-    // Animated ship
-    u8 shipY = 12 + (titleFrame / 10) % 3;
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_PLAYER), 20, shipY);
+    { 10,  4, "====================" },
+    { 10,  5, "   SPACE SHOOTER    " },
+    { 10,  6, "====================" },
+    { 12,  8, "Free Retro Games" },
+    { 17,  9, "v1.0.0" },
     
     // Player select (1P only)
-    VDP_drawText("--------------------", 10, 15);
-    VDP_drawText("START - Play Game", 12, 17);
-    VDP_drawText("--------------------", 10, 19);
+    { 10, 15, "--------------------" },
+    { 12, 17, "START - Play Game" },
+    { 10, 19, "--------------------" },
     
     // High score
-    char buf[24];
-    sprintf(buf, "High Score: %d", highScore);
-    VDP_drawText(buf, 13, 21);
-    
-    // Sound toggle
-    VDP_drawText("C: Sound", 16, 23);
-    VDP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
+    { 13, 21, hiScoreText },
+    { 16, 23, "C: Sound" },
     
     // Footer
-    VDP_drawText("(C) 2026 monteslu", 11, 27);
+    { 11, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+// Static text is in titleScreen, only what moves or toggles is drawn here
+static void drawTitle(void) {
+    TMAP_clear();
+    if (titleTimer) titleTimer--;
+    else {
+        titleTimer = 9;
+        titleStep = (titleStep == 2) ? 0 : titleStep + 1;
+    }
+    
+    // Animated stars background (moved by the scheduler)
+    for (u8 i = 0; i < MAX_STARS; i++) {
+        TMAP_setTile(TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_STAR), stars[i].x, stars[i].y);
+    }
+    
+    // Animated ship, one row every 10 frames
+    u8 shipY = 12 + titleStep;
+    TMAP_setTile(TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_PLAYER), 20, shipY);
+    
+    // Sound toggle
+    TMAP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 24);
 }
 
 static void drawGameOver() {
@@ -562,28 +572,25 @@ static void drawGameOver() {
     draw();
     
     // Overlay
-    if (frameCount % 10 < 5) {
-        VDP_drawText("=== GAME OVER ===", 11, 10);
+    if (FDIV_MOD10(frameCount) < 5) {
+        TMAP_drawText("=== GAME OVER ===", 11, 10);
     }
     
-    char buf[24];
-    sprintf(buf, "Final Score: %d", score);
-    VDP_drawText(buf, 12, 13);
-    
-    sprintf(buf, "Level Reached: %d", level);
-    VDP_drawText(buf, 12, 15);
-    
-    sprintf(buf, "Enemies Destroyed: %d", enemiesKilled);
-    VDP_drawText(buf, 10, 17);
+    TMAP_drawText(finalText[0], 12, 13);
+    TMAP_drawText(finalText[1], 12, 15);
+    TMAP_drawText(finalText[2], 10, 17);
     
-    if (score > highScore) {
-        highScore = score;
-        VDP_drawText("*** NEW HIGH SCORE! ***", 8, 20);
+    if (newHighScore) {
+        TMAP_drawText("*** NEW HIGH SCORE! ***", 8, 20);
     }
     
-    VDP_drawText("Press START", 14, 24);
+    TMAP_drawText("Press START", 14, 24);
 }
 
+// Busy play frame for the cycle benchmark: 8 enemies each paced and
+// rolling to shoot, the spawn timer and 2 stars wrapping
+static const BenchProfile benchProfile = { 19, 2, 0, 10, 0 };
+
 int main() {
     VDP_setScreenWidth320();
     PAL_setColor(0, RGB24_TO_VDPCOLOR(0x000022));  // Dark blue space
@@ -594,17 +601,44 @@ int main() {
     PAL_setColor(17, RGB24_TO_VDPCOLOR(0xFF0000)); // Red enemies
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0x00FF00)); // Green player
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0x00FFFF)); // Cyan power-ups
-    
+    PAL_setColor(50, RGB24_TO_VDPCOLOR(0xFFFFFF));
+    PAL_setColor(51, RGB24_TO_VDPCOLOR(0x0088FF));
+    
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("SPACE SHOOTER", &benchProfile);
+    
+    RNG_init(34463);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    TANIM_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    SPRL_init();
+    PART_init(32);
+    SCHED_init(0);
+    SCHED_addTask(PART_update, 4);
+    SCHED_addTask(updateStars, 2);
+    TMAP_init(BG_A, 0);
+    HUD_init(FALSE, 2);
+    HUD_setupCounter(HUD_SCORE, 7, 0, 7, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LEVEL, 19, 0, 3, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_LIVES, 32, 0, 2, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_COMBO, 37, 0, 3, HUD_ALIGN_LEFT);
+    sprintf(hiScoreText, "High Score: %lu", highScore);
     initStars();
     gameState = 0;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFFFF00), 20);  // Pulsing title color
+    SCRN_load(BG_B, titleScreen);
     drawTitle();
     
-    u16 lastJoy = 0;
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy; seed += frameCount;
+        SCHED_beginFrame();
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
         
         if (gameState == 0) {
             if (pressed & BUTTON_START) {
@@ -615,24 +649,31 @@ int main() {
                 soundEnabled = !soundEnabled;
                 playMenuBlip();
             }
-            drawTitle();
+            SCHED_runOptional();
+            // A new state has drawn its own screen already
+            if (gameState == 0) drawTitle();
         } else if (gameState == 1) {
-            update();
-            updateShake();
-            updateSound();
+            while (ticks-- && gameState == 1) update();
+            SCHED_runOptional();
             draw();
         } else {
             drawGameOver();
-            updateSound();
             if (pressed & BUTTON_START) {
                 playMenuBlip();
                 gameState = 0;
-                VDP_clearPlane(BG_A, TRUE);
+                HUD_show(FALSE);
+                PFX_stopAll();
+                PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFFFF00), 20);
+                sprintf(hiScoreText, "High Score: %lu", highScore);
+                SCRN_load(BG_B, titleScreen);
                 drawTitle();
             }
         }
         frameCount++;
+        TMAP_flush();
+        SPRL_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     return 0;
 }
@@ -7,25 +7,60 @@
  */
 
 #include <genesis.h>
+#include "resources.h"
+
+#include "common/audio.h"
+#include "common/bench.h"
+#include "common/coro.h"
+#include "common/fastdiv.h"
+#include "common/hud.h"
+#include "common/input.h"
+#include "common/kinematics.h"
+#include "common/loop.h"
+#include "common/palfx.h"
+#include "common/particles.h"
+#include "common/pool.h"
+#include "common/rng.h"
+#include "common/sched.h"
+#include "common/scratch.h"
+#include "common/screen.h"
+#include "common/scroll.h"
+#include "common/sfx.h"
+#include "common/sprites.h"
+#include "common/sweep.h"
+#include "common/tileanim.h"
+#include "common/tilemap.h"
+#include "common/trig.h"
+#include "common/vram.h"
 
 // Tile indices
-#define TILE_EMPTY      0
-#define TILE_TANK1      1
-#define TILE_TANK2      2
-#define TILE_BULLET     3
-#define TILE_WALL       4
-#define TILE_EXPLODE1   5
-#define TILE_EXPLODE2   6
-#define TILE_EXPLODE3   7
+#define TILE_EMPTY      (gameTiles + 0)
+#define TILE_TANK1      (gameTiles + 1)
+#define TILE_TANK2      (gameTiles + 2)
+#define TILE_BULLET     (gameTiles + 3)
+#define TILE_WALL       (gameTiles + 4)
+#define TILE_EXPLODE    (gameTiles + 5)   // animated in VRAM, see res/explode.png
+#define TILE_DEBRIS     (gameTiles + 6)
+
+// First tile of res/tiles.png, placed by the VRAM allocator
+static u16 gameTiles;
 
 #define ARENA_W         36
 #define ARENA_H         24
 #define ARENA_OFFSET_X  2
 #define ARENA_OFFSET_Y  3
 
-#define TANK_SPEED      1
-#define BULLET_SPEED    2
-#define FIRE_COOLDOWN   20
+// HUD counters (top three rows, above the arena)
+#define HUD_P1          0
+#define HUD_P2          1
+#define HUD_WIN         2
+
+// Pixels per frame; tanks glide one cell in 4 frames
+#define TANK_SPEED      FIX16(2)
+#define BULLET_SPEED    FIX16(8)
+#define FIRE_COOLDOWN   80
+#define AI_RANGE        14      // cells (across + down) the AI opens fire from
+#define AI_THINK_TICKS  4       // the AI decides at most this often, as it did per cell
 #define MAX_BULLETS     8
 
 #define DIR_UP          0
@@ -37,164 +72,118 @@
 #define STATE_PLAYING   1
 #define STATE_ROUNDOVER 2
 #define STATE_GAMEOVER  3
+#define STATE_PAUSED    4
 
 typedef struct {
-    s16 x, y;
+    s16 x, y;       // arena cell, taken as soon as the tank sets off
+    KinBody body;   // drawn position, glides to the cell
     u8 dir;
+    u8 aim;         // turret angle: 8-way for players, 16-way for the AI
     u8 alive;
     u8 fireCooldown;
     u8 score;
     u8 isAI;
     u8 aiTimer;
-    u8 flashTimer;
+    u8 thinkTimer;  // ticks to the AI's next decision
 } Tank;
 
 typedef struct {
-    s16 x, y;
-    s8 dx, dy;
-    u8 active;
+    KinBody body;   // screen pixels
     u8 owner;
 } Bullet;
 
-typedef struct {
-    s16 x, y;
-    u8 frame;
-    u8 timer;
-} Explosion;
+// CRAM entries the tank tiles are drawn with (PAL2 colour 1, PAL3 colour 2)
+static const u16 TANK_COLORS[2] = { 33, 50 };
 
 static Tank tanks[2];
 static Bullet bullets[MAX_BULLETS];
-static Explosion explosions[8];
+POOL_DEFINE(bulletPool, MAX_BULLETS);   // live bullets
+static u16 explodeAnim;
 static u8 arena[ARENA_H][ARENA_W];
 static u8 gameState;
 static u8 gameMode;
 static u8 winScore;
 static u16 frameCount;
-static u16 seed = 31337;
-
-// Screen shake
-static s16 shakeX = 0, shakeY = 0;
-static u8 shakeTimer = 0;
 
 // Sound toggle
 static u8 soundEnabled = 1;
 
 // High score
 static u16 highScore = 0;
+static char finalScore[24];  // formatted once when the match ends
+static char winnerText[24];
 
 // Title animation
-static u8 titleFrame = 0;
-
-static u16 rnd() {
-    seed = seed * 1103515245 + 12345;
-    return (seed >> 16) & 0x7FFF;
-}
+static u8 titleStep = 0;         // title tanks, one cell every 8 frames
+static u8 titleTimer = 7;
 
 // ============ SOUND EFFECTS ============
+// Scripts are { Hz, volume, frames, slide, fade }, played in vblank
+static const SfxStep shootSteps[] = { { 800, 14, 5, -30, 1 }, SFX_END };
+static const SfxStep boomSteps[] = { { 100, 15, 14, -2, 1 }, SFX_END };
+static const SfxStep bounceSteps[] = { { 400, 11, 4, 0, 1 }, SFX_END };
+static const SfxStep blipSteps[] = { { 1200, 12, 3, 0, 1 }, SFX_END };
+static const SfxStep victorySteps[] = {
+    { 600, 15, 5, 0, 0 }, { 800, 15, 5, 0, 0 }, { 1000, 15, 5, 0, 0 }, { 1400, 15, 30, 0, 2 }, SFX_END
+};
+static const SfxStep gameOverSteps[] = {
+    { 400, 15, 8, 0, 0 }, { 320, 15, 8, 0, 0 }, { 240, 15, 8, 0, 0 }, { 160, 15, 16, 0, 1 }, SFX_END
+};
+
+static const Sfx sfxShoot = { SFX_PRIO_LOW, FALSE, shootSteps };
+static const Sfx sfxBoom = { SFX_PRIO_HIGH, FALSE, boomSteps };
+static const Sfx sfxBounce = { SFX_PRIO_LOW, FALSE, bounceSteps };
+static const Sfx sfxBlip = { SFX_PRIO_LOW, FALSE, blipSteps };
+static const Sfx sfxVictory = { SFX_PRIO_JINGLE, FALSE, victorySteps };
+static const Sfx sfxGameOver = { SFX_PRIO_JINGLE, FALSE, gameOverSteps };
+
 static void playShoot() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 800);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 8);
+    SFX_play(&sfxShoot);
 }
 
 static void playExplosion() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(1, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(1, 100 + (rnd() % 50));
-    PSG_setEnvelope(1, PSG_ENVELOPE_MIN + 12);
-    // Noise for explosion
-    PSG_setEnvelope(3, PSG_ENVELOPE_MAX);
-    PSG_setNoise(PSG_NOISE_TYPE_WHITE, PSG_NOISE_FREQ_TONE3);
+    SFX_playPitch(&sfxBoom, RNG_range(RNG_FX, 50));
+    AUD_PLAY_PCM(explode_pcm, SFX_PRIO_HIGH);
 }
 
 static void playBounce() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(2, PSG_ENVELOPE_MAX - 4);
-    PSG_setFrequency(2, 400);
-    PSG_setEnvelope(2, PSG_ENVELOPE_MIN + 4);
+    SFX_play(&sfxBounce);
 }
 
 static void playMenuBlip() {
     if (!soundEnabled) return;
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1200);
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN + 3);
+    SFX_play(&sfxBlip);
 }
 
 static void playVictoryJingle() {
     if (!soundEnabled) return;
     // Rising arpeggio
-    for (u8 i = 0; i < 3; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 600 + i * 200);
-        for (u16 j = 0; j < 3000; j++) {}
-        PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-    PSG_setFrequency(0, 1400);
+    SFX_play(&sfxVictory);
 }
 
 static void playGameOverSound() {
     if (!soundEnabled) return;
     // Descending
-    for (u8 i = 0; i < 4; i++) {
-        PSG_setEnvelope(0, PSG_ENVELOPE_MAX);
-        PSG_setFrequency(0, 400 - i * 80);
-        for (u16 j = 0; j < 5000; j++) {}
-    }
-    PSG_setEnvelope(0, PSG_ENVELOPE_MIN);
-}
-
-static void updateSound() {
-    // Fade out sounds naturally
-    static u8 fadeTimer = 0;
-    fadeTimer++;
-    if (fadeTimer > 3) {
-        fadeTimer = 0;
-        for (u8 ch = 0; ch < 4; ch++) {
-            PSG_setEnvelope(ch, PSG_ENVELOPE_MIN);
-        }
-    }
+    SFX_play(&sfxGameOver);
 }
 
-// ============ SCREEN SHAKE ============
-static void startShake(u8 intensity) {
-    shakeTimer = intensity;
-}
-
-static void updateShake() {
-    if (shakeTimer > 0) {
-        shakeX = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeY = (rnd() % (shakeTimer * 2 + 1)) - shakeTimer;
-        shakeTimer--;
-    } else {
-        shakeX = shakeY = 0;
-    }
-    VDP_setHorizontalScroll(BG_A, shakeX);
-    VDP_setVerticalScroll(BG_A, shakeY);
+// Background track, on the Z80 for the whole game
+static void playMusic() {
+    if (!soundEnabled) return;
+    AUD_playMusic(game_music);
 }
 
 // ============ EXPLOSIONS ============
+// Arena cell (x, y): a blast cell plus debris sprites thrown outwards
 static void spawnExplosion(s16 x, s16 y) {
-    for (u8 i = 0; i < 8; i++) {
-        if (explosions[i].timer == 0) {
-            explosions[i].x = x;
-            explosions[i].y = y;
-            explosions[i].frame = 0;
-            explosions[i].timer = 20;
-            return;
-        }
-    }
-}
-
-static void updateExplosions() {
-    for (u8 i = 0; i < 8; i++) {
-        if (explosions[i].timer > 0) {
-            explosions[i].timer--;
-            explosions[i].frame = (20 - explosions[i].timer) / 7;
-        }
-    }
+    s16 px = (ARENA_OFFSET_X + x) * 8;
+    s16 py = (ARENA_OFFSET_Y + y) * 8;
+    PART_spawn(px, py, 0, 0, TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_EXPLODE), 20, 0);
+    PART_burst(px, py, 16, FIX16(2.5), TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_DEBRIS), 24, PART_SPRITE);
+    TANIM_play(explodeAnim);
 }
 
 static void generateArena() {
@@ -212,12 +201,12 @@ static void generateArena() {
     }
     
     // Random obstacles
-    u8 numWalls = 4 + (rnd() % 5);
+    u8 numWalls = 4 + RNG_range(RNG_GAME, 5);
     for (u8 i = 0; i < numWalls; i++) {
-        u8 x = 4 + (rnd() % (ARENA_W - 8));
-        u8 y = 4 + (rnd() % (ARENA_H - 8));
-        u8 w = 1 + (rnd() % 3);
-        u8 h = 1 + (rnd() % 3);
+        u8 x = 4 + RNG_range(RNG_GAME, ARENA_W - 8);
+        u8 y = 4 + RNG_range(RNG_GAME, ARENA_H - 8);
+        u8 w = 1 + RNG_range(RNG_GAME, 3);
+        u8 h = 1 + RNG_range(RNG_GAME, 3);
         
         for (u8 dy = 0; dy < h && y+dy < ARENA_H-1; dy++) {
             for (u8 dx = 0; dx < w && x+dx < ARENA_W-1; dx++) {
@@ -233,12 +222,8 @@ static void generateArena() {
     arena[ARENA_H/2+1][ARENA_W/2+1] = 1;
     
     // Clear bullets & explosions
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        bullets[i].active = FALSE;
-    }
-    for (u8 i = 0; i < 8; i++) {
-        explosions[i].timer = 0;
-    }
+    POOL_init(&bulletPool);
+    PART_clear();
 }
 
 static void spawnTank(Tank* t, u8 idx) {
@@ -246,15 +231,18 @@ static void spawnTank(Tank* t, u8 idx) {
         t->x = 3;
         t->y = ARENA_H / 2;
         t->dir = DIR_RIGHT;
+        t->aim = TRIG_RIGHT;
     } else {
         t->x = ARENA_W - 4;
         t->y = ARENA_H / 2;
         t->dir = DIR_LEFT;
+        t->aim = TRIG_LEFT;
     }
+    KIN_set(&t->body, (ARENA_OFFSET_X + t->x) * 8, (ARENA_OFFSET_Y + t->y) * 8, 0, 0);
     t->alive = TRUE;
     t->fireCooldown = 0;
     t->aiTimer = 0;
-    t->flashTimer = 0;
+    t->thinkTimer = 0;
 }
 
 static bool checkCollision(s16 x, s16 y) {
@@ -265,28 +253,17 @@ static bool checkCollision(s16 x, s16 y) {
 static void fireBullet(Tank* t, u8 owner) {
     if (t->fireCooldown > 0) return;
     
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].active) {
-            Bullet* b = &bullets[i];
-            b->x = t->x;
-            b->y = t->y;
-            b->dx = 0;
-            b->dy = 0;
-            
-            switch (t->dir) {
-                case DIR_UP:    b->dy = -BULLET_SPEED; b->y--; break;
-                case DIR_DOWN:  b->dy = BULLET_SPEED;  b->y++; break;
-                case DIR_LEFT:  b->dx = -BULLET_SPEED; b->x--; break;
-                case DIR_RIGHT: b->dx = BULLET_SPEED;  b->x++; break;
-            }
-            
-            b->active = TRUE;
-            b->owner = owner;
-            t->fireCooldown = FIRE_COOLDOWN;
-            playShoot();
-            return;
-        }
-    }
+    u8 i = POOL_alloc(&bulletPool);
+    if (i == POOL_NONE) return;
+    Bullet* b = &bullets[i];
+    
+    // Leave along the turret; the sweep skips the tank's own cell
+    b->body = t->body;
+    TRIG_polar(t->aim, BULLET_SPEED, &b->body.vx, &b->body.vy);
+    
+    b->owner = owner;
+    t->fireCooldown = FIRE_COOLDOWN;
+    playShoot();
 }
 
 static void updateAI(Tank* t, Tank* target, u8 owner) {
@@ -296,17 +273,17 @@ static void updateAI(Tank* t, Tank* target, u8 owner) {
     s16 dy = target->y - t->y;
     
     // Change direction periodically
-    if (t->aiTimer > 20 + (rnd() % 40)) {
+    if (t->aiTimer > 20 + RNG_range(RNG_AI, 40)) {
         t->aiTimer = 0;
         
-        if (rnd() % 3 != 0) {
+        if (!RNG_chance(RNG_AI, 3)) {
             if (abs(dx) > abs(dy)) {
                 t->dir = (dx > 0) ? DIR_RIGHT : DIR_LEFT;
             } else {
                 t->dir = (dy > 0) ? DIR_DOWN : DIR_UP;
             }
         } else {
-            t->dir = rnd() % 4;
+            t->dir = RNG_range(RNG_AI, 4);
         }
     }
     
@@ -326,29 +303,51 @@ static void updateAI(Tank* t, Tank* target, u8 owner) {
         t->aiTimer = 100; // Change direction sooner
     }
     
-    // Fire if aligned
-    bool aligned = FALSE;
-    if (t->dir == DIR_UP && abs(dx) < 2 && dy < 0) aligned = TRUE;
-    if (t->dir == DIR_DOWN && abs(dx) < 2 && dy > 0) aligned = TRUE;
-    if (t->dir == DIR_LEFT && abs(dy) < 2 && dx < 0) aligned = TRUE;
-    if (t->dir == DIR_RIGHT && abs(dy) < 2 && dx > 0) aligned = TRUE;
-    
-    if (aligned && (rnd() % 8) == 0) {
+    // Turret tracks the target in 16 steps, fire once it is close enough
+    t->aim = (TRIG_atan2(dy, dx) + 8) & 0xF0;
+    if (abs(dx) + abs(dy) < AI_RANGE && RNG_chance(RNG_AI, 8)) {
         fireBullet(t, owner);
     }
 }
 
+// Glide the drawn position towards the tank's cell; TRUE once it is there
+static bool glideTank(Tank* t) {
+    fix16 x = intToFix16((ARENA_OFFSET_X + t->x) * 8);
+    fix16 y = intToFix16((ARENA_OFFSET_Y + t->y) * 8);
+    t->body.x = KIN_approach(t->body.x, x, TANK_SPEED);
+    t->body.y = KIN_approach(t->body.y, y, TANK_SPEED);
+    return t->body.x == x && t->body.y == y;
+}
+
 static void updateTank(Tank* t, u8 idx) {
     if (!t->alive) return;
     if (t->fireCooldown > 0) t->fireCooldown--;
-    if (t->flashTimer > 0) t->flashTimer--;
+    
+    // Pick the next cell only once the last move has finished
+    bool arrived = glideTank(t);
     
     if (t->isAI) {
-        updateAI(t, &tanks[idx == 0 ? 1 : 0], idx);
+        // A blocked tank is always arrived, so pace it like a moving one
+        if (t->thinkTimer) t->thinkTimer--;
+        if (arrived && !t->thinkTimer) {
+            t->thinkTimer = AI_THINK_TICKS;
+            updateAI(t, &tanks[idx == 0 ? 1 : 0], idx);
+        }
         return;
     }
     
-    u16 joy = JOY_readJoypad(idx == 0 ? JOY_1 : JOY_2);
+    u16 joy = INPUT_held(idx == 0 ? JOY_1 : JOY_2);
+    
+    // Turret follows the pad, diagonals included, and stays put on release
+    s16 ax = ((joy & BUTTON_RIGHT) ? 1 : 0) - ((joy & BUTTON_LEFT) ? 1 : 0);
+    s16 ay = ((joy & BUTTON_DOWN) ? 1 : 0) - ((joy & BUTTON_UP) ? 1 : 0);
+    if (ax || ay) t->aim = TRIG_atan2(ay, ax);
+    
+    if (joy & (BUTTON_A | BUTTON_B | BUTTON_C)) {
+        fireBullet(t, idx);
+    }
+    if (!arrived) return;
+    
     s16 nx = t->x, ny = t->y;
     
     if (joy & BUTTON_UP)    { t->dir = DIR_UP;    ny--; }
@@ -361,241 +360,261 @@ static void updateTank(Tank* t, u8 idx) {
         t->x = nx;
         t->y = ny;
     }
+}
+
+static u8 bulletOwner;  // tank whose bullet is being swept
+
+// Sweep callback: walls and the other tank stop bullets
+static bool blocksBullet(s16 x, s16 y) {
+    x -= ARENA_OFFSET_X;
+    y -= ARENA_OFFSET_Y;
+    if (checkCollision(x, y)) return TRUE;
     
-    if (joy & (BUTTON_A | BUTTON_B | BUTTON_C)) {
-        fireBullet(t, idx);
+    for (u8 t = 0; t < 2; t++) {
+        if (t != bulletOwner && tanks[t].alive && x == tanks[t].x && y == tanks[t].y) return TRUE;
     }
+    return FALSE;
 }
 
 static void updateBullets() {
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
+    for (u16 n = POOL_COUNT(&bulletPool); n--; ) {
+        u8 i = POOL_AT(&bulletPool, n);
         Bullet* b = &bullets[i];
-        if (!b->active) continue;
         
-        b->x += b->dx;
-        b->y += b->dy;
+        // Every cell on the way is checked, so nothing is jumped over
+        SweepHit hit;
+        bulletOwner = b->owner;
+        if (!SWEEP_move(&b->body, 4, blocksBullet, &hit, FALSE)) continue;
         
-        // Wall collision
-        if (checkCollision(b->x, b->y)) {
-            b->active = FALSE;
-            playBounce();
-            continue;
-        }
+        POOL_free(&bulletPool, i);
+        s16 x = hit.cellX - ARENA_OFFSET_X;
+        s16 y = hit.cellY - ARENA_OFFSET_Y;
         
         // Tank collision
+        bool hitTank = FALSE;
         for (u8 t = 0; t < 2; t++) {
             if (!tanks[t].alive || t == b->owner) continue;
             
-            if (b->x == tanks[t].x && b->y == tanks[t].y) {
+            if (x == tanks[t].x && y == tanks[t].y) {
                 tanks[t].alive = FALSE;
                 tanks[b->owner].score++;
-                b->active = FALSE;
+                hitTank = TRUE;
                 
                 // JUICE!
                 spawnExplosion(tanks[t].x, tanks[t].y);
                 playExplosion();
-                startShake(6);
+                SCRL_ripple(SCRL_LAYERS, (ARENA_OFFSET_X + tanks[t].x) * 8 + 4,
+                            (ARENA_OFFSET_Y + tanks[t].y) * 8 + 4, 5, 30);
                 
                 // Flash winner's tank
-                tanks[b->owner].flashTimer = 30;
+                PFX_flash(TANK_COLORS[b->owner], RGB24_TO_VDPCOLOR(0xFFFFFF), 30, 2);
                 break;
             }
         }
+        
+        // Wall collision
+        if (!hitTank) playBounce();
     }
 }
 
+// Walls don't change during a round, so they go on BG_B once per round
 static void drawArena() {
-    VDP_clearPlane(BG_A, TRUE);
+    u16 row[ARENA_W];
     
-    // Draw arena
     for (u8 y = 0; y < ARENA_H; y++) {
         for (u8 x = 0; x < ARENA_W; x++) {
-            u16 tile = arena[y][x] ? TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL) : 0;
-            VDP_setTileMapXY(BG_A, tile, ARENA_OFFSET_X + x, ARENA_OFFSET_Y + y);
+            row[x] = arena[y][x] ? TILE_ATTR_FULL(PAL1, 0, 0, 0, TILE_WALL) : 0;
         }
+        VDP_setTileMapDataRect(BG_B, row, ARENA_OFFSET_X, ARENA_OFFSET_Y + y, ARENA_W, 1, ARENA_W, CPU);
     }
 }
 
 static void drawGame() {
     // Clear previous positions
-    drawArena();
+    TMAP_clear();
     
-    // Draw tanks with flash effect
+    // Draw tanks (scoring flash is done on their palette entries)
     for (u8 i = 0; i < 2; i++) {
         if (!tanks[i].alive) continue;
         
-        // Flash white when just scored
-        u8 pal = (tanks[i].flashTimer > 0 && (frameCount % 4 < 2)) ? PAL0 : (i == 0 ? PAL2 : PAL3);
-        u16 tile = TILE_ATTR_FULL(pal, 0, 0, 0, TILE_TANK1 + i);
-        VDP_setTileMapXY(BG_A, tile, ARENA_OFFSET_X + tanks[i].x, ARENA_OFFSET_Y + tanks[i].y);
+        u16 tile = TILE_ATTR_FULL(i == 0 ? PAL2 : PAL3, 0, 0, 0, TILE_TANK1 + i);
+        SPRL_add(KIN_X(&tanks[i].body), KIN_Y(&tanks[i].body), SPRITE_SIZE(1, 1), tile, TRUE);
     }
     
     // Draw bullets
-    for (u8 i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].active) continue;
+    for (u16 n = 0; n < POOL_COUNT(&bulletPool); n++) {
+        u8 i = POOL_AT(&bulletPool, n);
         u16 tile = TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_BULLET);
-        VDP_setTileMapXY(BG_A, tile, ARENA_OFFSET_X + bullets[i].x, ARENA_OFFSET_Y + bullets[i].y);
+        SPRL_add(KIN_X(&bullets[i].body), KIN_Y(&bullets[i].body), SPRITE_SIZE(1, 1), tile, FALSE);
     }
     
-    // Draw explosions
-    for (u8 i = 0; i < 8; i++) {
-        if (explosions[i].timer > 0) {
-            u16 tile = TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_EXPLODE1 + explosions[i].frame);
-            VDP_setTileMapXY(BG_A, tile, ARENA_OFFSET_X + explosions[i].x, ARENA_OFFSET_Y + explosions[i].y);
-        }
-    }
+    // Draw explosions and debris
+    PART_draw();
     
     // HUD
-    char buf[20];
-    sprintf(buf, "P1:%d", tanks[0].score);
-    VDP_drawText(buf, 1, 1);
-    sprintf(buf, "P2:%d", tanks[1].score);
-    VDP_drawText(buf, 34, 1);
-    sprintf(buf, "FIRST TO %d", winScore);
-    VDP_drawText(buf, 14, 1);
+    HUD_setCounter(HUD_P1, tanks[0].score);
+    HUD_setCounter(HUD_P2, tanks[1].score);
+    HUD_setCounter(HUD_WIN, winScore);
     
     // Sound indicator
-    VDP_drawText(soundEnabled ? "SND" : "---", 19, 27);
+    TMAP_drawText(soundEnabled ? "SND" : "---", 19, 27);
 }
 
-static void drawTitle(void) {
-    VDP_clearPlane(BG_A, TRUE);
-    
-    // Pulsing title color
-    if (titleFrame % 30 < 15) {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFFFF));
-    } else {
-        PAL_setColor(1, RGB24_TO_VDPCOLOR(0xFFFF00));
-    }
-    
+// ============ SCREENS ============
+// Static text, sent to BG_B once on entering the state
+static const ScreenText titleScreen[] = {
     // Standard title block
-    VDP_drawText("====================", 10, 4);
-    VDP_drawText("    TANK BATTLE     ", 10, 5);
-    VDP_drawText("====================", 10, 6);
-    VDP_drawText("Free Retro Games", 12, 8);
-    VDP_drawText("v1.0.0", 17, 9);
-    
-    // Animated tanks
-    u8 tankPos = 10 + (titleFrame / 8) % 20;
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_TANK1), tankPos, 12);
-    VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_TANK2), 30 - (titleFrame / 8) % 20, 12);
+    { 10,  4, "====================" },
+    { 10,  5, "    TANK BATTLE     " },
+    { 10,  6, "====================" },
+    { 12,  8, "Free Retro Games" },
+    { 17,  9, "v1.0.0" },
     
     // Player select
-    VDP_drawText("--------------------", 10, 14);
-    VDP_drawText("START - 1 Player", 12, 16);
-    VDP_drawText("    A - 2 Players", 12, 18);
-    VDP_drawText("--------------------", 10, 20);
+    { 10, 14, "--------------------" },
+    { 12, 16, "START - 1 Player" },
+    { 12, 18, "    A - 2 Players" },
+    { 10, 20, "--------------------" },
     
-    VDP_drawText("First to 5 wins!", 12, 22);
-    
-    // Sound toggle
-    VDP_drawText("C: Sound", 16, 24);
-    VDP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 25);
+    { 12, 22, "First to 5 wins!" },
+    { 16, 24, "C: Sound" },
     
     // Footer
-    VDP_drawText("(C) 2026 monteslu", 11, 27);
+    { 11, 27, "(C) 2026 monteslu" },
+    SCRN_END
+};
+
+static const ScreenText gameOverScreen[] = {
+    { 10, 12, finalScore },
+    {  9, 15, winnerText },
+    { 12, 17, "CONGRATULATIONS!" },
+    {  8, 22, "Press START to continue" },
+    SCRN_END
+};
+
+// Static text is in titleScreen, only what moves or toggles is drawn here
+static void drawTitle(void) {
+    TMAP_clear();
+    
+    // Animated tanks
+    TMAP_setTile(TILE_ATTR_FULL(PAL2, 0, 0, 0, TILE_TANK1), 10 + titleStep, 12);
+    TMAP_setTile(TILE_ATTR_FULL(PAL3, 0, 0, 0, TILE_TANK2), 30 - titleStep, 12);
+    
+    // Sound toggle
+    TMAP_drawText(soundEnabled ? "[ON] " : "[OFF]", 17, 25);
     
-    titleFrame++;
+    if (titleTimer) titleTimer--;
+    else {
+        titleTimer = 7;
+        titleStep = (titleStep == 19) ? 0 : titleStep + 1;
+    }
 }
 
 static void drawRoundOver() {
     // Flash the score
-    if (frameCount % 8 < 4) {
+    if (!(frameCount & 4)) {
         if (!tanks[0].alive) {
-            VDP_drawText("** Player 2 scores! **", 9, 12);
+            TMAP_drawText("** Player 2 scores! **", 9, 12);
         } else {
-            VDP_drawText("** Player 1 scores! **", 9, 12);
+            TMAP_drawText("** Player 1 scores! **", 9, 12);
         }
     }
 }
 
 static void drawGameOver() {
-    VDP_clearPlane(BG_A, TRUE);
+    TMAP_clear();
     
     // Flashing GAME OVER
-    if (frameCount % 10 < 5) {
-        VDP_drawText("===== GAME OVER =====", 9, 8);
-    } else {
-        VDP_drawText("      GAME OVER      ", 9, 8);
-    }
-    
-    char buf[32];
-    sprintf(buf, "Final Score: %d - %d", tanks[0].score, tanks[1].score);
-    VDP_drawText(buf, 10, 12);
-    
-    if (tanks[0].score >= winScore) {
-        VDP_drawText("*** PLAYER 1 WINS! ***", 9, 15);
-        VDP_drawText("CONGRATULATIONS!", 12, 17);
+    if (FDIV_MOD10(frameCount) < 5) {
+        TMAP_drawText("===== GAME OVER =====", 9, 8);
     } else {
-        VDP_drawText("*** PLAYER 2 WINS! ***", 9, 15);
-        VDP_drawText("CONGRATULATIONS!", 12, 17);
+        TMAP_drawText("      GAME OVER      ", 9, 8);
     }
-    
-    VDP_drawText("Press START to continue", 8, 22);
 }
 
 static void startRound() {
     generateArena();
     spawnTank(&tanks[0], 0);
     spawnTank(&tanks[1], 1);
+    drawArena();
     gameState = STATE_PLAYING;
 }
 
+// Hold the round result on screen, then the next round or the final score
+static bool roundOverTask(Coro* c) {
+    CORO_BEGIN(c);
+    if (tanks[0].score >= winScore || tanks[1].score >= winScore) {
+        CORO_WAIT(c, 90);
+        gameState = STATE_GAMEOVER;
+        AUD_stopMusic();
+        PART_clear();
+        
+        // Update high score
+        u8 maxScore = tanks[0].score > tanks[1].score ? tanks[0].score : tanks[1].score;
+        if (maxScore > highScore) highScore = maxScore;
+        
+        playVictoryJingle();
+        sprintf(finalScore, "Final Score: %d - %d", tanks[0].score, tanks[1].score);
+        sprintf(winnerText, "*** PLAYER %d WINS! ***", tanks[0].score >= winScore ? 1 : 2);
+        SCRN_load(BG_B, gameOverScreen);
+        HUD_show(FALSE);
+        drawGameOver();
+    } else {
+        CORO_WAIT(c, 60);
+        playMenuBlip();
+        startRound();
+    }
+    CORO_END(c);
+}
+
+// Run while paused; the main loop keeps drawing the frozen arena
+static bool pauseTask(Coro* c) {
+    CORO_BEGIN(c);
+    // Shadow dims the arena, the high priority text stays bright
+    PFX_setShadowHighlight(TRUE);
+    AUD_pauseMusic();
+    // Started the frame START went down; wait for a fresh press
+    CORO_YIELD(c);
+    CORO_WAIT_UNTIL(c, INPUT_pressed(JOY_1) & BUTTON_START);
+    PFX_setShadowHighlight(FALSE);
+    AUD_resumeMusic();
+    gameState = STATE_PLAYING;
+    CORO_END(c);
+}
+
 static void startGame(u8 mode) {
+    // Arenas and AI moves depend only on this seed, so a match can be replayed
+    RNG_init(frameCount);
     gameMode = mode;
     winScore = 5;
     tanks[0].score = 0;
     tanks[0].isAI = FALSE;
     tanks[1].score = 0;
     tanks[1].isAI = (mode == 0);
+    PFX_stop(1);
+    VDP_clearPlane(BG_B, TRUE);  // drop the title text
+    HUD_clear();
+    HUD_drawText("P1:", 1, 1);
+    HUD_drawText("FIRST TO", 14, 1);
+    HUD_drawText("P2:", 34, 1);
+    HUD_show(TRUE);
     playMenuBlip();
+    playMusic();
     startRound();
 }
 
 static void createTiles() {
-    // Simple solid color tiles
-    u32 tileData[8];
-    
-    // Tile 0: empty (transparent)
-    memset(tileData, 0, 32);
-    VDP_loadTileData(tileData, TILE_EMPTY, 1, CPU);
-    
-    // Tile 1: Tank 1 (solid green)
-    memset(tileData, 0x11, 32);
-    VDP_loadTileData(tileData, TILE_TANK1, 1, CPU);
-    
-    // Tile 2: Tank 2 (solid blue)
-    memset(tileData, 0x22, 32);
-    VDP_loadTileData(tileData, TILE_TANK2, 1, CPU);
-    
-    // Tile 3: Bullet (solid yellow)
-    memset(tileData, 0x33, 32);
-    VDP_loadTileData(tileData, TILE_BULLET, 1, CPU);
-    
-    // Tile 4: Wall (solid gray)
-    memset(tileData, 0x44, 32);
-    VDP_loadTileData(tileData, TILE_WALL, 1, CPU);
-    
-    // Explosion tiles - expanding pattern
-    // Explosion 1 - small
-    memset(tileData, 0, 32);
-    tileData[3] = 0x00033000;
-    tileData[4] = 0x00033000;
-    VDP_loadTileData(tileData, TILE_EXPLODE1, 1, CPU);
-    
-    // Explosion 2 - medium
-    memset(tileData, 0, 32);
-    tileData[2] = 0x00333300;
-    tileData[3] = 0x03333330;
-    tileData[4] = 0x03333330;
-    tileData[5] = 0x00333300;
-    VDP_loadTileData(tileData, TILE_EXPLODE2, 1, CPU);
-    
-    // Explosion 3 - large
-    memset(tileData, 0x33, 32);
-    VDP_loadTileData(tileData, TILE_EXPLODE3, 1, CPU);
+    // Tile art is res/tiles.png, sent in one DMA
+    gameTiles = VRAM_loadTileSet(&game_tiles);
+    
+    // Explosion expands once per blast, 7 frames per step
+    explodeAnim = TANIM_add(TILE_EXPLODE, explode_anim.tiles, explode_anim.numTile, 7, FALSE);
 }
 
+// 1 player frame for the cycle benchmark: the AI's turn timer and its
+// fire roll
+static const BenchProfile benchProfile = { 1, 0, 1, 1, 0 };
+
 int main() {
     VDP_setScreenWidth320();
     VDP_setBackgroundColor(0);
@@ -609,20 +628,40 @@ int main() {
     PAL_setColor(33, RGB24_TO_VDPCOLOR(0x00FF00));  // PAL2: green (P1)
     PAL_setColor(49, RGB24_TO_VDPCOLOR(0x0088FF));  // PAL3: blue (P2)
     
+    // Hold A+B+C at power on for the cycle benchmark
+    if (BENCH_requested()) BENCH_run("TANK BATTLE", &benchProfile);
+    
+    RNG_init(31337);
+    INPUT_init();
+    LOOP_init();
+    AUD_init();
+    SFX_init();
+    CORO_init();
+    TANIM_init();
+    VRAM_init();
     createTiles();
+    PFX_init();
+    SCRL_init();
+    SPRL_init();
+    PART_init(32);
+    SCHED_init(0);
+    SCHED_addTask(PART_update, 4);
+    TMAP_init(BG_A, 0);
+    HUD_init(FALSE, 3);
+    HUD_setupCounter(HUD_P1, 4, 1, 2, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_WIN, 23, 1, 2, HUD_ALIGN_LEFT);
+    HUD_setupCounter(HUD_P2, 37, 1, 2, HUD_ALIGN_LEFT);
     
     gameState = STATE_TITLE;
+    PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFFFF00), 30);  // Pulsing title color
+    SCRN_load(BG_B, titleScreen);
     drawTitle();
     
-    u16 lastJoy = 0;
-    u8 roundTimer = 0;
-    
     while(TRUE) {
-        u16 joy = JOY_readJoypad(JOY_1);
-        u16 pressed = joy & ~lastJoy;
-        lastJoy = joy;
-        
-        seed += frameCount;
+        SCHED_beginFrame();
+        u16 ticks = LOOP_beginFrame();
+        u16 pressed = INPUT_pressed(JOY_1);
+        u16 taskTicks = ticks;  // the tick loop counts 'ticks' down
         
         switch (gameState) {
             case STATE_TITLE:
@@ -637,76 +676,69 @@ int main() {
                     soundEnabled = !soundEnabled;
                     playMenuBlip();
                 }
-                drawTitle();
+                // A new state has drawn its own screen already
+                if (gameState == STATE_TITLE) drawTitle();
                 break;
                 
             case STATE_PLAYING:
-                if (frameCount % 4 == 0) {  // Slow down movement
+                while (ticks-- && gameState == STATE_PLAYING) {
                     updateTank(&tanks[0], 0);
                     updateTank(&tanks[1], 1);
-                }
-                if (frameCount % 2 == 0) {  // Bullets move faster
                     updateBullets();
+                    
+                    if (!tanks[0].alive || !tanks[1].alive) {
+                        gameState = STATE_ROUNDOVER;
+                        drawRoundOver();
+                        CORO_start(roundOverTask);
+                    }
                 }
                 
-                updateExplosions();
-                updateShake();
-                updateSound();
-                
-                if (!tanks[0].alive || !tanks[1].alive) {
-                    gameState = STATE_ROUNDOVER;
-                    roundTimer = 0;
-                    drawRoundOver();
-                }
+                SCHED_runOptional();
                 
                 if (pressed & BUTTON_START) {
-                    VDP_drawText("** PAUSED **", 14, 14);
-                    while(!(JOY_readJoypad(JOY_1) & BUTTON_START)) {
-                        SYS_doVBlankProcess();
-                    }
+                    gameState = STATE_PAUSED;
+                    CORO_start(pauseTask);
                 }
                 
                 drawGame();
                 break;
                 
             case STATE_ROUNDOVER:
-                roundTimer++;
-                updateExplosions();
-                updateShake();
-                updateSound();
+                // roundOverTask moves on when the result has been shown
+                SCHED_runOptional();
                 drawGame();
                 drawRoundOver();
+                break;
                 
-                if (tanks[0].score >= winScore || tanks[1].score >= winScore) {
-                    if (roundTimer > 90) {
-                        gameState = STATE_GAMEOVER;
-                        
-                        // Update high score
-                        u8 maxScore = tanks[0].score > tanks[1].score ? tanks[0].score : tanks[1].score;
-                        if (maxScore > highScore) highScore = maxScore;
-                        
-                        playVictoryJingle();
-                        drawGameOver();
-                    }
-                } else if (roundTimer > 60) {
-                    playMenuBlip();
-                    startRound();
-                }
+            case STATE_PAUSED:
+                // Simulation and optional work stand still, the arena stays up
+                drawGame();
+                TMAP_drawTextEx("** PAUSED **", TILE_ATTR(PAL0, TRUE, FALSE, FALSE), 14, 14);
                 break;
                 
             case STATE_GAMEOVER:
                 if (pressed & BUTTON_START) {
                     gameState = STATE_TITLE;
                     playMenuBlip();
-                    titleFrame = 0;
+                    titleStep = 0;
+                    titleTimer = 7;
+                    PFX_pulse(1, RGB24_TO_VDPCOLOR(0xFFFF00), 30);
+                    SCRN_load(BG_B, titleScreen);
                     drawTitle();
                 }
-                drawGameOver();
+                if (gameState == STATE_GAMEOVER) drawGameOver();
                 break;
         }
         
+        // After the state's own input, so a press a task waited for is not
+        // seen again by the state it hands back to
+        CORO_update(taskTicks);
+        
         frameCount++;
+        TMAP_flush();
+        SPRL_flush();
         SYS_doVBlankProcess();
+        SCRATCH_reset();
     }
     
     return 0;